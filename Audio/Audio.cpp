@@ -33,10 +33,49 @@ Sound::Sound() noexcept : id{0}
 
 Sound::Sound(Name name) noexcept : id{sound_ids[name]}
 {
+    acquire(id);
 }
 
 Sound::Sound(WzNode src) noexcept : id{add_sound(src)}
 {
+    acquire(id);
+}
+
+Sound::Sound(const Sound& other) noexcept : id{other.id}
+{
+    acquire(id);
+}
+
+Sound::Sound(Sound&& other) noexcept : id{other.id}
+{
+    other.id = 0;
+}
+
+Sound::~Sound()
+{
+    release(id);
+}
+
+Sound& Sound::operator=(const Sound& other) noexcept
+{
+    if (id != other.id) {
+        acquire(other.id);
+        release(id);
+        id = other.id;
+    }
+
+    return *this;
+}
+
+Sound& Sound::operator=(Sound&& other) noexcept
+{
+    if (this != &other) {
+        release(id);
+        id = other.id;
+        other.id = 0;
+    }
+
+    return *this;
 }
 
 void Sound::play() const noexcept
@@ -46,7 +85,7 @@ void Sound::play() const noexcept
     }
 
     if (auto sample_iter = samples.find(id); sample_iter != samples.end()) {
-        Mix_PlayChannel(-1, sample_iter->second, 0);
+        Mix_PlayChannel(-1, sample_iter->second.chunk, 0);
     }
 }
 
@@ -108,9 +147,10 @@ void Sound::close() noexcept
     }
 
     for (auto [_, sample] : samples) {
-        Mix_FreeChunk(sample);
+        Mix_FreeChunk(sample.chunk);
     }
     samples.clear();
+    pcm_bytes = 0;
 
     Mix_CloseAudio();
     Mix_Quit();
@@ -128,6 +168,19 @@ void Sound::set_sfx_volume(std::uint8_t vol) noexcept
     Mix_Volume(-1, MIX_MAX_VOLUME * static_cast<int>(vol) / 100);
 }
 
+void Sound::free_unused() noexcept
+{
+    for (auto iter = samples.begin(); iter != samples.end();) {
+        if (iter->second.refs == 0) {
+            pcm_bytes -= iter->second.chunk->alen;
+            Mix_FreeChunk(iter->second.chunk);
+            iter = samples.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 std::size_t Sound::add_sound(WzNode src) noexcept
 {
     if (!initialized) {
@@ -135,19 +188,30 @@ std::size_t Sound::add_sound(WzNode src) noexcept
     }
 
     WzAudio ad = src.getAudio();
+    std::size_t id = ad.getId();
+
+    // Samples are shared, so only decode audio which is not loaded yet.
+    if (samples.find(id) != samples.end()) {
+        return id;
+    }
 
     auto data = ad.getAudioData();
 
-    if (data) {
-        std::size_t id = ad.getId();
+    if (!data) {
+        return 0;
+    }
 
-        samples[id] = Mix_LoadWAV_RW(
-            SDL_RWFromConstMem(data + 82, ad.getLength() - 82), 0);
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(
+        SDL_RWFromConstMem(data + 82, ad.getLength() - 82), 0);
 
-        return id;
-    } else {
+    if (!chunk) {
         return 0;
     }
+
+    samples.emplace(id, Sample{chunk, 0});
+    pcm_bytes += chunk->alen;
+
+    return id;
 }
 
 void Sound::add_sound(Name name, WzNode src) noexcept
@@ -159,16 +223,46 @@ void Sound::add_sound(Name name, WzNode src) noexcept
     std::size_t id = add_sound(src);
 
     if (id) {
+        // Preloaded sounds stay loaded until the audio system is closed.
+        acquire(id);
         sound_ids[name] = id;
     }
 }
 
+void Sound::acquire(std::size_t id) noexcept
+{
+    if (!initialized) {
+        return;
+    }
+
+    if (auto sample_iter = samples.find(id); sample_iter != samples.end()) {
+        sample_iter->second.refs++;
+    }
+}
+
+void Sound::release(std::size_t id) noexcept
+{
+    if (!initialized) {
+        return;
+    }
+
+    if (auto sample_iter = samples.find(id); sample_iter != samples.end()) {
+        sample_iter->second.refs--;
+    }
+}
+
 bool Sound::is_initialized() noexcept
 {
     return initialized;
 }
 
-std::unordered_map<std::size_t, Mix_Chunk*> Sound::samples;
+std::size_t Sound::get_pcm_bytes() noexcept
+{
+    return pcm_bytes;
+}
+
+std::unordered_map<std::size_t, Sound::Sample> Sound::samples;
+std::size_t Sound::pcm_bytes = 0;
 EnumMap<Sound::Name, std::size_t> Sound::sound_ids;
 bool Sound::initialized = false;
 
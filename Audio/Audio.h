@@ -54,6 +54,12 @@ public:
     Sound() noexcept;
     Sound(Name name) noexcept;
     Sound(WzNode src) noexcept;
+    Sound(const Sound& other) noexcept;
+    Sound(Sound&& other) noexcept;
+    ~Sound();
+
+    Sound& operator=(const Sound& other) noexcept;
+    Sound& operator=(Sound&& other) noexcept;
 
     void play() const noexcept;
 
@@ -61,16 +67,31 @@ public:
     static void init_sfx() noexcept;
     static void close() noexcept;
     static void set_sfx_volume(std::uint8_t volume) noexcept;
+    //! Free all samples which are no longer referenced by any sound.
+    static void free_unused() noexcept;
 
     [[nodiscard]] static bool is_initialized() noexcept;
+    //! Return the number of bytes of decoded audio held by all samples.
+    [[nodiscard]] static std::size_t get_pcm_bytes() noexcept;
 
 private:
+    //! A decoded sample, shared by all sounds with the same audio id.
+    struct Sample {
+        Mix_Chunk* chunk;
+        std::size_t refs;
+    };
+
     std::size_t id;
 
     static std::size_t add_sound(WzNode src) noexcept;
     static void add_sound(Sound::Name name, WzNode src) noexcept;
+    static void acquire(std::size_t id) noexcept;
+    static void release(std::size_t id) noexcept;
 
-    static std::unordered_map<std::size_t, Mix_Chunk*> samples;
+    //! Emptied by `close()`. Sounds released after that, such as those
+    //! owned by static caches, leave it untouched.
+    static std::unordered_map<std::size_t, Sample> samples;
+    static std::size_t pcm_bytes;
     static EnumMap<Name, std::size_t> sound_ids;
     static bool initialized;
 };
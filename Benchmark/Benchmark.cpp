@@ -0,0 +1,339 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "../Character/Char.h"
+#include "../Constants.h"
+#include "../Gameplay/Combat/DamageNumber.h"
+#include "../Gameplay/Stage.h"
+#include "../Graphics/GraphicsGL.h"
+#include "../IO/UI.h"
+#include "../IO/Window.h"
+#include "../Net/Session.h"
+#include "../Util/Allocations.h"
+#include "../Util/Profiler.h"
+#include "../Util/Randomizer.h"
+#include "HeadlessContext.h"
+#include "Scene.h"
+#include "Wz.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace jrc
+{
+namespace
+{
+//! Samples of one measurement, one per frame.
+class Samples
+{
+public:
+    explicit Samples(std::size_t frames)
+    {
+        values.reserve(frames);
+    }
+
+    void add(std::int64_t value)
+    {
+        values.push_back(value);
+    }
+
+    //! Return the value below which `percent` percent of the samples lie.
+    std::int64_t percentile(std::int32_t percent) const
+    {
+        if (values.empty()) {
+            return 0;
+        }
+
+        std::vector<std::int64_t> sorted = values;
+        std::size_t rank = (sorted.size() - 1) * percent / 100;
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+
+        return sorted[rank];
+    }
+
+    std::int64_t max() const
+    {
+        if (values.empty()) {
+            return 0;
+        }
+
+        return *std::max_element(values.begin(), values.end());
+    }
+
+private:
+    std::vector<std::int64_t> values;
+};
+
+void print_row(const char* name, const Samples& samples, const char* unit)
+{
+    std::cout << std::left << std::setw(20) << name << std::right
+              << std::setw(10) << samples.percentile(50) << std::setw(10)
+              << samples.percentile(99) << std::setw(10) << samples.max()
+              << "  " << unit << '\n';
+}
+
+std::int64_t microseconds_since(
+    std::chrono::steady_clock::time_point& point) noexcept
+{
+    auto last = point;
+    point = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(point - last)
+        .count();
+}
+
+Error init(HeadlessContext& context, const char* data_path)
+{
+    // Like the client, set up rendering while the game files are read.
+    std::future<void> wz_loading = std::async(
+        std::launch::async, [data_path] { WzFile::loadAll(data_path); });
+
+    if (Error error = context.init(); error) {
+        return error;
+    }
+
+    if (Error error = GraphicsGL::get().init(); error) {
+        return error;
+    }
+
+    context.bind_target(Constants::VIEW_WIDTH, Constants::VIEW_HEIGHT);
+
+    // Rethrows any error raised while reading the game files.
+    wz_loading.get();
+
+    Char::init();
+    DamageNumber::init();
+    MapPortals::init();
+    Stage::get().init();
+
+    return Error::NONE;
+}
+
+//! Per-frame measurements of a run.
+class FrameReport
+{
+public:
+    explicit FrameReport(std::size_t frame_count)
+        : packet_time{frame_count},
+          update_time{frame_count},
+          draw_time{frame_count},
+          flush_time{frame_count},
+          frame_time{frame_count},
+          quads{frame_count},
+          draw_calls{frame_count},
+          texture_binds{frame_count},
+          composites{frame_count},
+          atlas_uploads{frame_count},
+          frame_allocations{frame_count},
+          frames{0}
+    {
+    }
+
+    //! Run one frame: handle pending packets, update the game by one
+    //! timestep, then draw it. The frame is only recorded if `measured`.
+    void run_frame(const HeadlessContext& context, bool with_ui, bool measured)
+    {
+        GraphicsGL& graphics = GraphicsGL::get();
+
+        const GraphicsGL::AtlasStats& atlas = graphics.get_atlas_stats();
+        std::size_t uploads_before = atlas.uploads + atlas.reuploads;
+        std::size_t allocations_before = Allocations::count();
+
+        auto point = std::chrono::steady_clock::now();
+
+        Session::get().read();
+        std::int64_t packet_us = microseconds_since(point);
+
+        // Map changes wait for the window to fade out.
+        Window::get().update();
+        Stage::get().update();
+        if (with_ui) {
+            UI::get().update();
+        }
+        std::int64_t update_us = microseconds_since(point);
+
+        graphics.clearscene();
+        Stage::get().draw(1.0f);
+        if (with_ui) {
+            UI::get().draw(1.0f);
+        }
+        std::int64_t draw_us = microseconds_since(point);
+
+        graphics.flush(1.0f);
+        context.finish();
+        std::int64_t flush_us = microseconds_since(point);
+
+        if (!measured) {
+            return;
+        }
+
+        ++frames;
+        packet_time.add(packet_us);
+        update_time.add(update_us);
+        draw_time.add(draw_us);
+        flush_time.add(flush_us);
+        frame_time.add(packet_us + update_us + draw_us + flush_us);
+
+        const GraphicsGL::FrameStats& stats = graphics.get_frame_stats();
+        quads.add(stats.quads);
+        draw_calls.add(stats.draw_calls);
+        texture_binds.add(stats.texture_binds);
+        composites.add(stats.composites);
+        atlas_uploads.add(atlas.uploads + atlas.reuploads - uploads_before);
+        frame_allocations.add(Allocations::count() - allocations_before);
+    }
+
+    void print(std::int32_t warmup) const
+    {
+        std::cout << frames << " frames after " << warmup
+                  << " warm-up frames\n\n"
+                  << std::left << std::setw(20) << "" << std::right
+                  << std::setw(10) << "p50" << std::setw(10) << "p99"
+                  << std::setw(10) << "max" << '\n';
+        print_row("packets", packet_time, "us");
+        print_row("update", update_time, "us");
+        print_row("draw", draw_time, "us");
+        print_row("flush", flush_time, "us");
+        print_row("frame", frame_time, "us");
+        print_row("quads", quads, "");
+        print_row("draw calls", draw_calls, "");
+        print_row("texture binds", texture_binds, "");
+        print_row("composites", composites, "");
+        print_row("atlas uploads", atlas_uploads, "");
+        print_row("allocations", frame_allocations, "");
+    }
+
+private:
+    Samples packet_time;
+    Samples update_time;
+    Samples draw_time;
+    Samples flush_time;
+    Samples frame_time;
+    Samples quads;
+    Samples draw_calls;
+    Samples texture_binds;
+    Samples composites;
+    Samples atlas_uploads;
+    Samples frame_allocations;
+    std::size_t frames;
+};
+
+//! Run the scene and print per-frame statistics for its measured frames.
+void run_scene(const Scene& scene, const HeadlessContext& context)
+{
+    Randomizer::seed(scene.get_seed());
+
+    scene.spawn();
+    Player& player = Stage::get().get_player();
+    Point<std::int16_t> origin = player.get_position();
+
+    FrameReport report{static_cast<std::size_t>(scene.get_frames())};
+    for (std::int32_t frame = -scene.get_warmup();
+         frame < scene.get_frames();
+         ++frame) {
+        player.set_position(
+            scene.camera_target(origin, std::max(frame, 0)));
+        report.run_frame(context, false, frame >= 0);
+    }
+
+    report.print(scene.get_warmup());
+    Stage::get().clear();
+}
+
+//! Replay a packet log through the game, drawing the stage and UI, until
+//! all packets have been handled. Prints per-frame statistics.
+Error run_replay(const char* log,
+                 bool realtime,
+                 const HeadlessContext& context)
+{
+    UI::get().init();
+
+    if (Error error = Session::get().init_replay(log, realtime); error) {
+        return error;
+    }
+
+    // Also records the handler time of each opcode.
+    Profiler::get().set_enabled(true);
+
+    // Ten minutes at 60 frames per second.
+    FrameReport report{36'000};
+    while (Session::get().is_connected()) {
+        report.run_frame(context, true, true);
+    }
+
+    report.print(0);
+    std::cout << '\n';
+    Session::get().get_packet_switch().dump_stats(std::cout);
+
+    return Error::NONE;
+}
+} // namespace
+} // namespace jrc
+
+//! Renders a scripted scene or replays a packet log without a window, and
+//! reports how long each phase of a frame takes, along with the work done
+//! per frame.
+//!
+//! Usage: JourneyBenchmark <game data directory> <scene file>
+//!        JourneyBenchmark <game data directory> --replay <log> [--realtime]
+int main(int argc, char** argv)
+{
+    bool replay = argc >= 4 && std::string_view{argv[2]} == "--replay";
+    bool realtime = argc == 5 && std::string_view{argv[4]} == "--realtime";
+    if (argc != 3 && !(replay && (argc == 4 || realtime))) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <game data directory> <scene file>\n"
+                  << "       " << argv[0]
+                  << " <game data directory> --replay <log> [--realtime]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    std::optional<jrc::Scene> scene;
+    if (!replay) {
+        scene.emplace(argv[2]);
+        if (!*scene) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    jrc::HeadlessContext context;
+    jrc::Error error = jrc::init(context, argv[1]);
+    if (!error) {
+        if (scene) {
+            jrc::run_scene(*scene, context);
+        } else {
+            error = jrc::run_replay(argv[3], realtime, context);
+        }
+    }
+
+    if (error) {
+        std::cerr << "Error: " << error.get_message() << error.get_args()
+                  << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "HeadlessContext.h"
+
+#include <cstring>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+namespace jrc
+{
+namespace
+{
+EGLDisplay get_display() noexcept
+{
+    using GetPlatformDisplay
+        = EGLDisplay (*)(EGLenum, void*, const EGLint*);
+
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (extensions
+        && std::strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+        auto get_platform_display = reinterpret_cast<GetPlatformDisplay>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display) {
+            EGLDisplay surfaceless = get_platform_display(
+                EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (surfaceless != EGL_NO_DISPLAY) {
+                return surfaceless;
+            }
+        }
+    }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+} // namespace
+
+HeadlessContext::~HeadlessContext()
+{
+    if (framebuffer) {
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteRenderbuffers(1, &colorbuffer);
+    }
+
+    if (display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(
+            display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context != EGL_NO_CONTEXT) {
+            eglDestroyContext(display, context);
+        }
+        eglTerminate(display);
+    }
+}
+
+Error HeadlessContext::init()
+{
+    display = get_display();
+    if (display == EGL_NO_DISPLAY
+        || !eglInitialize(display, nullptr, nullptr)) {
+        return {Error::WINDOW, "No EGL display is available."};
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        return {Error::WINDOW, "EGL does not support desktop OpenGL."};
+    }
+
+    // The client renders with the compatibility profile, so no version is
+    // requested; drivers then hand out the newest compatibility context.
+    const EGLint config_attribs[]
+        = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLConfig config = nullptr;
+    EGLint num_configs = 0;
+    eglChooseConfig(display, config_attribs, &config, 1, &num_configs);
+
+    context = eglCreateContext(
+        display, num_configs ? config : nullptr, EGL_NO_CONTEXT, nullptr);
+    if (context == EGL_NO_CONTEXT) {
+        return {Error::WINDOW, "Could not create an EGL context."};
+    }
+
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        return {Error::WINDOW, "Could not make the EGL context current."};
+    }
+
+    return Error::NONE;
+}
+
+void HeadlessContext::bind_target(std::int16_t width, std::int16_t height)
+{
+    glGenRenderbuffers(1, &colorbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER,
+                              GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER,
+                              colorbuffer);
+
+    glViewport(0, 0, width, height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+}
+
+void HeadlessContext::finish() const
+{
+    glFinish();
+}
+} // namespace jrc
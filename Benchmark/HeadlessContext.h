@@ -0,0 +1,53 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../Error.h"
+
+#include <EGL/egl.h>
+#include <GL/glew.h>
+#include <cstdint>
+
+namespace jrc
+{
+//! An OpenGL context without a window, for rendering in environments that
+//! have no display server. The context is created through EGL, preferring
+//! Mesa's surfaceless platform, and renders into an offscreen framebuffer.
+class HeadlessContext
+{
+public:
+    HeadlessContext() noexcept = default;
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    //! Create the context and make it current on the calling thread.
+    Error init();
+    //! Create the framebuffer to render into and bind it. Must be called
+    //! after the GL entry points have been loaded.
+    void bind_target(std::int16_t width, std::int16_t height);
+    //! Block until all submitted GL commands have completed.
+    void finish() const;
+
+private:
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+    GLuint framebuffer = 0;
+    GLuint colorbuffer = 0;
+};
+} // namespace jrc
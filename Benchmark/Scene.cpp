@@ -0,0 +1,177 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "Scene.h"
+
+#include "../Gameplay/MapleMap/Mob.h"
+#include "../Gameplay/Stage.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace jrc
+{
+Scene::Scene(const std::string& filename)
+    : valid{false}, map_id{0}, portal_id{0}, seed{0}, warmup{60}
+{
+    std::ifstream file{filename};
+    if (!file) {
+        std::cerr << "Could not open scene " << filename << '\n';
+        return;
+    }
+
+    std::int32_t next_oid = 1;
+    std::int32_t line_number = 0;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream args{line};
+        std::string command;
+        if (!(args >> command)) {
+            continue;
+        }
+
+        bool parsed = false;
+        if (command == "map") {
+            std::int32_t portal = 0;
+            parsed = static_cast<bool>(args >> map_id);
+            args >> portal;
+            portal_id = static_cast<std::int8_t>(portal);
+        } else if (command == "seed") {
+            parsed = static_cast<bool>(args >> seed);
+        } else if (command == "warmup") {
+            parsed = args >> warmup && warmup >= 0;
+        } else if (command == "mob") {
+            std::int32_t id;
+            std::int16_t x, y;
+            std::int32_t stance = Mob::MOVE;
+            if (args >> id >> x >> y) {
+                args >> stance;
+                // Mode 0 leaves the mob uncontrolled, so it never sends
+                // movement packets.
+                mobs.emplace_back(next_oid++,
+                                  id,
+                                  0,
+                                  static_cast<std::int8_t>(stance),
+                                  0,
+                                  false,
+                                  -1,
+                                  Point<std::int16_t>{x, y});
+                parsed = true;
+            }
+        } else if (command == "npc") {
+            std::int32_t id;
+            std::int16_t x, y;
+            std::int32_t flip = 0;
+            if (args >> id >> x >> y) {
+                args >> flip;
+                npcs.emplace_back(next_oid++,
+                                  id,
+                                  Point<std::int16_t>{x, y},
+                                  flip != 0,
+                                  0);
+                parsed = true;
+            }
+        } else if (command == "path") {
+            std::int16_t x, y;
+            std::int32_t frames;
+            if (args >> x >> y >> frames && frames > 0) {
+                path.push_back({{x, y}, frames});
+                parsed = true;
+            }
+        }
+
+        if (!parsed) {
+            std::cerr << filename << ':' << line_number
+                      << ": invalid command '" << line << "'\n";
+            return;
+        }
+    }
+
+    if (!map_id || path.empty()) {
+        std::cerr << filename << ": a scene needs a map and a path\n";
+        return;
+    }
+
+    valid = true;
+}
+
+Scene::operator bool() const noexcept
+{
+    return valid;
+}
+
+void Scene::spawn() const
+{
+    Stage& stage = Stage::get();
+    stage.load(map_id, portal_id);
+
+    for (const MobSpawn& mob : mobs) {
+        stage.get_mobs().spawn(MobSpawn{mob});
+    }
+    for (const NpcSpawn& npc : npcs) {
+        stage.get_npcs().spawn(NpcSpawn{npc});
+    }
+}
+
+Point<std::int16_t> Scene::camera_target(Point<std::int16_t> origin,
+                                         std::int32_t frame) const noexcept
+{
+    Point<std::int16_t> from = origin;
+
+    for (const Waypoint& waypoint : path) {
+        if (frame < waypoint.frames) {
+            float t = static_cast<float>(frame) / waypoint.frames;
+            Point<std::int16_t> delta = waypoint.position - from;
+
+            return from
+                   + Point<std::int16_t>{
+                       static_cast<std::int16_t>(delta.x() * t),
+                       static_cast<std::int16_t>(delta.y() * t)};
+        }
+
+        frame -= waypoint.frames;
+        from = waypoint.position;
+    }
+
+    return from;
+}
+
+std::uint64_t Scene::get_seed() const noexcept
+{
+    return seed;
+}
+
+std::int32_t Scene::get_warmup() const noexcept
+{
+    return warmup;
+}
+
+std::int32_t Scene::get_frames() const noexcept
+{
+    std::int32_t frames = 0;
+    for (const Waypoint& waypoint : path) {
+        frames += waypoint.frames;
+    }
+
+    return frames;
+}
+} // namespace jrc
@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../Gameplay/Spawn.h"
+#include "../Template/Point.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace jrc
+{
+//! A scripted benchmark scene: the map to load, the objects to spawn on it
+//! and the path the camera follows.
+//!
+//! Scenes are plain text files with one command per line. Everything after
+//! a `#` is a comment.
+//!
+//!     map <map id> [portal id]
+//!     seed <random seed>
+//!     warmup <frames>
+//!     mob <mob id> <x> <y> [stance]
+//!     npc <npc id> <x> <y> [flip]
+//!     path <x> <y> <frames>
+//!
+//! Each `path` command moves the camera from the previous waypoint (or the
+//! spawn point) to the given position over the given number of frames, so
+//! the frames of all `path` commands add up to the length of the run.
+class Scene
+{
+public:
+    //! Parse the scene script at `filename`. Errors are reported to the
+    //! console and leave the scene invalid.
+    explicit Scene(const std::string& filename);
+
+    //! Whether the script was parsed successfully.
+    explicit operator bool() const noexcept;
+
+    //! Load the map on the stage and queue all objects to be spawned.
+    void spawn() const;
+
+    //! Return the position the camera should follow at `frame`, starting
+    //! from `origin`.
+    Point<std::int16_t> camera_target(Point<std::int16_t> origin,
+                                      std::int32_t frame) const noexcept;
+
+    std::uint64_t get_seed() const noexcept;
+    std::int32_t get_warmup() const noexcept;
+    //! Return the number of measured frames.
+    std::int32_t get_frames() const noexcept;
+
+private:
+    struct Waypoint {
+        Point<std::int16_t> position;
+        std::int32_t frames;
+    };
+
+    bool valid;
+    std::int32_t map_id;
+    std::int8_t portal_id;
+    std::uint64_t seed;
+    std::int32_t warmup;
+    std::vector<MobSpawn> mobs;
+    std::vector<NpcSpawn> npcs;
+    std::vector<Waypoint> path;
+};
+} // namespace jrc
@@ -151,6 +151,11 @@ std::uint16_t Char::get_attack_delay(std::size_t no) const
     return static_cast<std::uint16_t>(delay / fspeed);
 }
 
+PhysicsObject* Char::prepare_physics()
+{
+    return nullptr;
+}
+
 std::int8_t Char::update(const Physics& physics)
 {
     update(physics, 1.0f);
@@ -61,6 +61,8 @@ public:
 
     //! Draw look, nametag, effects and chat bubble.
     void draw(double viewx, double viewy, float alpha) const override;
+    //! Characters move themselves during `update`.
+    PhysicsObject* prepare_physics() override;
     //! Update look and movements.
     std::int8_t update(const Physics& physics) override;
     //! Return the current map layer, or 7 if on a ladder or rope.
@@ -32,6 +32,7 @@ Body::Body(std::int32_t skin, const BodyDrawinfo& draw_info)
     str_img[3] = '1';
     WzNode head_node = WzFile::character[str_img];
 
+    FrameTable<Texture>::Builder textures;
     for (auto iter : Stance::names) {
         Stance::Id stance = iter.first;
         const std::string& stance_name = iter.second;
@@ -41,8 +42,7 @@ Body::Body(std::int32_t skin, const BodyDrawinfo& draw_info)
             continue;
         }
 
-        for (std::uint8_t frame = 0; ;
-             ++frame) {
+        for (std::uint8_t frame : BodyDrawinfo::get_frames(stance_node)) {
             WzNode frame_node = stance_node[frame];
             for (auto s_part_node = frame_node.begin(); s_part_node != frame_node.end() ; ++s_part_node ) {
                 WzNode part_node = (*s_part_node).second;
@@ -66,9 +66,8 @@ Body::Body(std::int32_t skin, const BodyDrawinfo& draw_info)
                         break;
                     }
 
-                    stances[stance][layer]
-                        .emplace(frame, part_node)
-                        .first->second.shift(shift);
+                    textures.add(slot(stance, layer), frame, part_node)
+                        .shift(shift);
                 }
             }
 
@@ -77,13 +76,14 @@ Body::Body(std::int32_t skin, const BodyDrawinfo& draw_info)
                 Point<std::int16_t> shift
                     = draw_info.get_head_pos(stance, frame);
 
-                stances[stance][Layer::HEAD]
-                    .emplace(frame, head_s_f_node)
-                    .first->second.shift(shift);
+                textures.add(slot(stance, Layer::HEAD), frame, head_s_f_node)
+                    .shift(shift);
             }
         }
     }
 
+    stances = textures.build(Stance::LENGTH * NUM_LAYERS);
+
     static constexpr const std::size_t NUM_SKIN_TYPES = 12ull;
     static constexpr const char* const skin_types[NUM_SKIN_TYPES] = {"Light",
                                                                      "Tan",
@@ -106,12 +106,9 @@ void Body::draw(Stance::Id stance,
                 std::uint8_t frame,
                 const DrawArgument& args) const
 {
-    auto frame_it = stances[stance][layer].find(frame);
-    if (frame_it == stances[stance][layer].end()) {
-        return;
+    if (const Texture* texture = stances.find(slot(stance, layer), frame)) {
+        texture->draw(args);
     }
-
-    frame_it->second.draw(args);
 }
 
 std::string_view Body::get_name() const noexcept
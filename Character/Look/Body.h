@@ -51,8 +51,13 @@ public:
     static Layer layer_by_name(const std::string& name);
 
 private:
-    std::unordered_map<std::uint8_t, Texture> stances[Stance::LENGTH]
-                                                     [Layer::NUM_LAYERS];
+    static std::size_t slot(Stance::Id stance, Layer layer) noexcept
+    {
+        return static_cast<std::size_t>(stance) * NUM_LAYERS + layer;
+    }
+
+    //! Indexed by stance and layer, see `slot()`.
+    FrameTable<Texture> stances;
     std::string name;
 
     static const std::unordered_map<std::string, Layer> layers_by_name;
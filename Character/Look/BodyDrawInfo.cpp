@@ -19,7 +19,9 @@
 
 #include "Body.h"
 #include "Wz.h"
-#include "Wz.h"
+
+#include <algorithm>
+#include <cstdint>
 
 namespace jrc
 {
@@ -28,22 +30,31 @@ void BodyDrawinfo::init()
     WzNode body_node = WzFile::character["00002000.img"];
     WzNode head_node = WzFile::character["00012000.img"];
 
+    FrameTable<FrameInfo>::Builder stances;
+    FrameTable<BodyAction>::Builder actions;
+
     for (auto s_stance_node = body_node.begin(); s_stance_node != body_node.end() ; ++s_stance_node) {
         WzNode stance_node = (*s_stance_node).second;
         std::string st_str = stance_node.name();
 
         std::uint16_t attack_delay = 0;
-        for (std::uint8_t frame = 0; ;
-             ++frame) {
+        for (std::uint8_t frame : get_frames(stance_node)) {
             WzNode frame_node = stance_node[frame];
             bool is_action
                 = frame_node["action"].getNodeType() == WzNode::NodeType::STRING;
             if (is_action) {
-                BodyAction action = frame_node;
-                body_actions[st_str][frame] = action;
+                auto [iter, _] = action_ids.try_emplace(
+                    st_str, static_cast<ActionId>(action_ids.size()));
+                ActionId action_id = iter->second;
+                if (action_id >= attack_delays.size()) {
+                    attack_delays.resize(action_id + 1u);
+                }
+
+                const BodyAction& action
+                    = actions.add(action_id, frame, frame_node);
 
                 if (action.is_attack_frame()) {
-                    attack_delays[st_str].push_back(attack_delay);
+                    attack_delays[action_id].push_back(attack_delay);
                 }
                 attack_delay += action.get_delay();
             } else {
@@ -52,8 +63,6 @@ void BodyDrawinfo::init()
                 if (delay <= 0) {
                     delay = 100;
                 }
-                stance_delays[stance][frame]
-                    = static_cast<std::uint16_t>(delay);
 
                 std::unordered_map<
                     Body::Layer,
@@ -82,9 +91,10 @@ void BodyDrawinfo::init()
                                                        map_node);
                 }
 
-                body_positions[stance][frame]
-                    = body_shift_map[Body::BODY]["navel"];
-                arm_positions[stance][frame]
+                FrameInfo& info = stances.add(stance, frame);
+                info.delay = static_cast<std::uint16_t>(delay);
+                info.body = body_shift_map[Body::BODY]["navel"];
+                info.arm
                     = body_shift_map.count(Body::ARM)
                           ? (body_shift_map[Body::ARM]["hand"]
                              - body_shift_map[Body::ARM]["navel"]
@@ -92,94 +102,94 @@ void BodyDrawinfo::init()
                           : (body_shift_map[Body::ARM_OVER_HAIR]["hand"]
                              - body_shift_map[Body::ARM_OVER_HAIR]["navel"]
                              + body_shift_map[Body::BODY]["navel"]);
-                hand_positions[stance][frame]
+                info.hand
                     = body_shift_map[Body::HAND_BELOW_WEAPON]["handMove"];
-                head_positions[stance][frame]
-                    = body_shift_map[Body::BODY]["neck"]
-                      - body_shift_map[Body::HEAD]["neck"];
-                face_positions[stance][frame]
-                    = body_shift_map[Body::BODY]["neck"]
-                      - body_shift_map[Body::HEAD]["neck"]
-                      + body_shift_map[Body::HEAD]["brow"];
-                hair_positions[stance][frame]
-                    = body_shift_map[Body::HEAD]["brow"]
-                      - body_shift_map[Body::HEAD]["neck"]
-                      + body_shift_map[Body::BODY]["neck"];
+                info.head = body_shift_map[Body::BODY]["neck"]
+                            - body_shift_map[Body::HEAD]["neck"];
+                info.face = body_shift_map[Body::BODY]["neck"]
+                            - body_shift_map[Body::HEAD]["neck"]
+                            + body_shift_map[Body::HEAD]["brow"];
+                info.hair = body_shift_map[Body::HEAD]["brow"]
+                            - body_shift_map[Body::HEAD]["neck"]
+                            + body_shift_map[Body::BODY]["neck"];
             }
         }
     }
+
+    stance_frames = stances.build(Stance::LENGTH);
+    body_actions = actions.build(action_ids.size());
 }
 
-Point<std::int16_t> BodyDrawinfo::get_body_pos(Stance::Id stance,
-                                               std::uint8_t frame) const
+std::vector<std::uint8_t> BodyDrawinfo::get_frames(WzNode stance_node)
 {
-    auto iter = body_positions[stance].find(frame);
-    if (iter == body_positions[stance].end()) {
-        return {};
+    std::vector<std::uint8_t> frames;
+    for (auto s_sub = stance_node.begin(); s_sub != stance_node.end();
+         ++s_sub) {
+        std::string name = (*s_sub).second.name();
+        if (name.empty() || name.size() > 3
+            || !std::all_of(name.begin(), name.end(), [](char c) {
+                   return c >= '0' && c <= '9';
+               })) {
+            continue;
+        }
+
+        int frame = std::stoi(name);
+        if (frame <= UINT8_MAX) {
+            frames.push_back(static_cast<std::uint8_t>(frame));
+        }
     }
 
-    return iter->second;
+    std::sort(frames.begin(), frames.end());
+
+    return frames;
+}
+
+Point<std::int16_t> BodyDrawinfo::get_body_pos(Stance::Id stance,
+                                               std::uint8_t frame) const
+{
+    const FrameInfo* info = stance_frames.find(stance, frame);
+    return info ? info->body : Point<std::int16_t>{};
 }
 
 Point<std::int16_t> BodyDrawinfo::get_arm_pos(Stance::Id stance,
                                               std::uint8_t frame) const
 {
-    auto iter = arm_positions[stance].find(frame);
-    if (iter == arm_positions[stance].end()) {
-        return {};
-    }
-
-    return iter->second;
+    const FrameInfo* info = stance_frames.find(stance, frame);
+    return info ? info->arm : Point<std::int16_t>{};
 }
 
 Point<std::int16_t> BodyDrawinfo::get_hand_pos(Stance::Id stance,
                                                std::uint8_t frame) const
 {
-    auto iter = hand_positions[stance].find(frame);
-    if (iter == hand_positions[stance].end()) {
-        return {};
-    }
-
-    return iter->second;
+    const FrameInfo* info = stance_frames.find(stance, frame);
+    return info ? info->hand : Point<std::int16_t>{};
 }
 
 Point<std::int16_t> BodyDrawinfo::get_head_pos(Stance::Id stance,
                                                std::uint8_t frame) const
 {
-    auto iter = head_positions[stance].find(frame);
-    if (iter == head_positions[stance].end()) {
-        return {};
-    }
-
-    return iter->second;
+    const FrameInfo* info = stance_frames.find(stance, frame);
+    return info ? info->head : Point<std::int16_t>{};
 }
 
 Point<std::int16_t> BodyDrawinfo::get_hair_pos(Stance::Id stance,
                                                std::uint8_t frame) const
 {
-    auto iter = hair_positions[stance].find(frame);
-    if (iter == hair_positions[stance].end()) {
-        return {};
-    }
-
-    return iter->second;
+    const FrameInfo* info = stance_frames.find(stance, frame);
+    return info ? info->hair : Point<std::int16_t>{};
 }
 
 Point<std::int16_t> BodyDrawinfo::get_face_pos(Stance::Id stance,
                                                std::uint8_t frame) const
 {
-    auto iter = face_positions[stance].find(frame);
-    if (iter == face_positions[stance].end()) {
-        return {};
-    }
-
-    return iter->second;
+    const FrameInfo* info = stance_frames.find(stance, frame);
+    return info ? info->face : Point<std::int16_t>{};
 }
 
 std::uint8_t BodyDrawinfo::next_frame(Stance::Id stance,
                                       std::uint8_t frame) const
 {
-    if (stance_delays[stance].count(frame + 1)) {
+    if (stance_frames.find(stance, frame + 1)) {
         return frame + 1;
     } else {
         return 0;
@@ -189,48 +199,40 @@ std::uint8_t BodyDrawinfo::next_frame(Stance::Id stance,
 std::uint16_t BodyDrawinfo::get_delay(Stance::Id stance,
                                       std::uint8_t frame) const
 {
-    auto iter = stance_delays[stance].find(frame);
-    if (iter == stance_delays[stance].end()) {
-        return 100u;
-    }
+    const FrameInfo* info = stance_frames.find(stance, frame);
+    return info ? info->delay : 100u;
+}
 
-    return iter->second;
+BodyDrawinfo::ActionId
+BodyDrawinfo::get_action_id(const std::string& action) const
+{
+    auto iter = action_ids.find(action);
+    return iter == action_ids.end() ? NULL_ACTION : iter->second;
 }
 
-std::uint16_t BodyDrawinfo::get_attack_delay(const std::string& action,
+std::uint16_t BodyDrawinfo::get_attack_delay(ActionId action,
                                              std::size_t no) const
 {
-    auto action_iter = attack_delays.find(action);
-    if (action_iter != attack_delays.end()) {
-        if (no < action_iter->second.size()) {
-            return action_iter->second[no];
+    if (action < attack_delays.size()) {
+        if (no < attack_delays[action].size()) {
+            return attack_delays[action][no];
         }
     }
     return 0;
 }
 
-std::uint8_t BodyDrawinfo::next_action_frame(const std::string& action,
+std::uint8_t BodyDrawinfo::next_action_frame(ActionId action,
                                              std::uint8_t frame) const
 {
-    auto action_iter = body_actions.find(action);
-    if (action_iter != body_actions.end()) {
-        if (action_iter->second.count(frame + 1)) {
-            return frame + 1;
-        }
+    if (body_actions.find(action, frame + 1)) {
+        return frame + 1;
     }
     return 0;
 }
 
-const BodyAction* BodyDrawinfo::get_action(const std::string& action,
+const BodyAction* BodyDrawinfo::get_action(ActionId action,
                                            std::uint8_t frame) const
 {
-    auto action_iter = body_actions.find(action);
-    if (action_iter != body_actions.end()) {
-        auto frame_iter = action_iter->second.find(frame);
-        if (frame_iter != action_iter->second.end()) {
-            return &(frame_iter->second);
-        }
-    }
-    return nullptr;
+    return body_actions.find(action, frame);
 }
 } // namespace jrc
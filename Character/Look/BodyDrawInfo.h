@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "../../Template/FrameTable.h"
 #include "../../Template/Point.h"
 #include "Stance.h"
 
@@ -88,8 +89,17 @@ private:
 class BodyDrawinfo
 {
 public:
+    //! Identifies an action, eg. the motion of a skill, in place of its
+    //! name.
+    using ActionId = std::uint16_t;
+    static constexpr const ActionId NULL_ACTION = 0xFFFF;
+
     void init();
 
+    //! Return the numbers of the frames below a node of a stance, in
+    //! ascending order.
+    static std::vector<std::uint8_t> get_frames(WzNode stance_node);
+
     Point<std::int16_t> get_body_pos(Stance::Id stance,
                                      std::uint8_t frame) const;
     Point<std::int16_t> get_arm_pos(Stance::Id stance,
@@ -105,32 +115,32 @@ public:
     std::uint8_t next_frame(Stance::Id stance, std::uint8_t frame) const;
     std::uint16_t get_delay(Stance::Id stance, std::uint8_t frame) const;
 
-    std::uint16_t get_attack_delay(const std::string& action,
-                                   std::size_t no) const;
-    std::uint8_t next_action_frame(const std::string& action,
-                                   std::uint8_t frame) const;
-    const BodyAction* get_action(const std::string& action,
-                                 std::uint8_t frame) const;
+    //! Return the id of the action with the given name, or `NULL_ACTION`
+    //! if there is none.
+    ActionId get_action_id(const std::string& action) const;
+    std::uint16_t get_attack_delay(ActionId action, std::size_t no) const;
+    std::uint8_t next_action_frame(ActionId action, std::uint8_t frame) const;
+    const BodyAction* get_action(ActionId action, std::uint8_t frame) const;
 
 private:
-    std::unordered_map<std::uint8_t, Point<std::int16_t>>
-        body_positions[Stance::LENGTH];
-    std::unordered_map<std::uint8_t, Point<std::int16_t>>
-        arm_positions[Stance::LENGTH];
-    std::unordered_map<std::uint8_t, Point<std::int16_t>>
-        hand_positions[Stance::LENGTH];
-    std::unordered_map<std::uint8_t, Point<std::int16_t>>
-        head_positions[Stance::LENGTH];
-    std::unordered_map<std::uint8_t, Point<std::int16_t>>
-        hair_positions[Stance::LENGTH];
-    std::unordered_map<std::uint8_t, Point<std::int16_t>>
-        face_positions[Stance::LENGTH];
-    std::unordered_map<std::uint8_t, std::uint16_t>
-        stance_delays[Stance::LENGTH];
-
-    std::unordered_map<std::string,
-                       std::unordered_map<std::uint8_t, BodyAction>>
-        body_actions;
-    std::unordered_map<std::string, std::vector<std::uint16_t>> attack_delays;
+    //! Where the parts of the body are and how long it is shown, for a
+    //! frame of a stance.
+    struct FrameInfo {
+        Point<std::int16_t> body;
+        Point<std::int16_t> arm;
+        Point<std::int16_t> hand;
+        Point<std::int16_t> head;
+        Point<std::int16_t> hair;
+        Point<std::int16_t> face;
+        std::uint16_t delay;
+    };
+
+    //! Indexed by stance.
+    FrameTable<FrameInfo> stance_frames;
+
+    std::unordered_map<std::string, ActionId> action_ids;
+    //! Indexed by action id.
+    FrameTable<BodyAction> body_actions;
+    std::vector<std::vector<std::uint16_t>> attack_delays;
 };
 } // namespace jrc
@@ -17,6 +17,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "CharLook.h"
 
+#include "../../Configuration.h"
 #include "../../Constants.h"
 #include "../../Data/WeaponData.h"
 
@@ -51,7 +52,7 @@ void CharLook::reset()
     flip = true;
 
     action = nullptr;
-    action_str = "";
+    action_id = BodyDrawinfo::NULL_ACTION;
     act_frame = 0;
 
     set_stance(Stance::STAND1);
@@ -68,6 +69,38 @@ void CharLook::draw(const DrawArgument& args,
                     Expression::Id inter_expression,
                     std::uint8_t inter_frame,
                     std::uint8_t inter_exp_frame) const
+{
+    // Rotating the whole image would turn the layers around another point
+    // than each of their own centers.
+    if (Configuration::get().video.composite_characters
+        && args.get_angle() == 0.0f) {
+        std::uint32_t key = static_cast<std::uint32_t>(inter_stance) << 24
+                            | static_cast<std::uint32_t>(inter_frame) << 16
+                            | static_cast<std::uint32_t>(inter_expression)
+                                  << 8
+                            | static_cast<std::uint32_t>(inter_exp_frame);
+        bool drawn = composites.draw(key, args, [&]() {
+            draw_layers({},
+                        inter_stance,
+                        inter_expression,
+                        inter_frame,
+                        inter_exp_frame);
+        });
+
+        if (drawn) {
+            return;
+        }
+    }
+
+    draw_layers(
+        args, inter_stance, inter_expression, inter_frame, inter_exp_frame);
+}
+
+void CharLook::draw_layers(const DrawArgument& args,
+                           Stance::Id inter_stance,
+                           Expression::Id inter_expression,
+                           std::uint8_t inter_frame,
+                           std::uint8_t inter_exp_frame) const
 {
     Point<std::int16_t> face_shift
         = draw_info.get_face_pos(inter_stance, inter_frame);
@@ -432,9 +465,9 @@ bool CharLook::update(std::uint16_t timestep)
         if (timestep >= delta) {
             st_elapsed = timestep - delta;
 
-            act_frame = draw_info.next_action_frame(action_str, act_frame);
+            act_frame = draw_info.next_action_frame(action_id, act_frame);
             if (act_frame > 0) {
-                action = draw_info.get_action(action_str, act_frame);
+                action = draw_info.get_action(action_id, act_frame);
 
                 float threshold = static_cast<float>(delta) / timestep;
                 stance.next(action->get_stance(), threshold);
@@ -442,7 +475,7 @@ bool CharLook::update(std::uint16_t timestep)
             } else {
                 ani_end = true;
                 action = nullptr;
-                action_str = "";
+                action_id = BodyDrawinfo::NULL_ACTION;
                 set_stance(Stance::STAND1);
             }
         } else {
@@ -492,6 +525,7 @@ void CharLook::set_body(std::int32_t skin_id)
                    .first;
     }
     body = &iter->second;
+    composites.clear();
 }
 
 void CharLook::set_hair(std::int32_t hair_id)
@@ -505,6 +539,7 @@ void CharLook::set_hair(std::int32_t hair_id)
                    .first;
     }
     hair = &iter->second;
+    composites.clear();
 }
 
 void CharLook::set_face(std::int32_t face_id)
@@ -514,6 +549,7 @@ void CharLook::set_face(std::int32_t face_id)
         iter = face_types.emplace(face_id, face_id).first;
     }
     face = &iter->second;
+    composites.clear();
 }
 
 void CharLook::update_two_handed()
@@ -525,12 +561,14 @@ void CharLook::update_two_handed()
 void CharLook::add_equip(std::int32_t item_id)
 {
     equips.add_equip(item_id, draw_info);
+    composites.clear();
     update_two_handed();
 }
 
 void CharLook::remove_equip(Equipslot::Id slot)
 {
     equips.remove_equip(slot);
+    composites.clear();
     if (slot == Equipslot::WEAPON) {
         update_two_handed();
     }
@@ -674,19 +712,24 @@ void CharLook::set_expression(Expression::Id new_expression)
 
 void CharLook::set_action(const std::string& ac_str)
 {
-    if (ac_str == action_str || ac_str.empty()) {
+    if (ac_str.empty()) {
         return;
     }
 
     if (Stance::Id ac_stance = Stance::by_string(ac_str)) {
         set_stance(ac_stance);
     } else {
-        action = draw_info.get_action(ac_str, 0);
+        BodyDrawinfo::ActionId ac_id = draw_info.get_action_id(ac_str);
+        if (ac_id == action_id) {
+            return;
+        }
+
+        action = draw_info.get_action(ac_id, 0);
 
         if (action) {
             act_frame = 0;
             st_elapsed = 0;
-            action_str = ac_str;
+            action_id = ac_id;
 
             stance.set(action->get_stance());
             st_frame.set(action->get_frame());
@@ -722,7 +765,7 @@ std::uint16_t CharLook::get_attack_delay(std::size_t no,
                                          std::uint8_t first_frame) const
 {
     if (action) {
-        return draw_info.get_attack_delay(action_str, no);
+        return draw_info.get_attack_delay(action_id, no);
     } else {
         std::uint16_t delay = 0;
         for (std::uint8_t frame = 0; frame < first_frame; ++frame) {
@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "../../Graphics/CompositeCache.h"
 #include "../../Net/Login.h"
 #include "../../Template/Interpolated.h"
 #include "../../Util/Randomizer.h"
@@ -72,11 +73,18 @@ public:
 
 private:
     void update_two_handed();
+    //! Draw the composite image of a pose, or its layers one by one if
+    //! there is none.
     void draw(const DrawArgument& args,
               Stance::Id inter_stance,
               Expression::Id inter_expression,
               std::uint8_t inter_frame,
               std::uint8_t inter_exp_frame) const;
+    void draw_layers(const DrawArgument& args,
+                     Stance::Id inter_stance,
+                     Expression::Id inter_expression,
+                     std::uint8_t inter_frame,
+                     std::uint8_t inter_exp_frame) const;
     std::uint16_t get_delay(Stance::Id stance, std::uint8_t frame) const;
     std::uint8_t get_next_frame(Stance::Id stance, std::uint8_t frame) const;
     Stance::Id get_attack_stance(std::uint8_t attack, bool degenerate) const;
@@ -92,7 +100,7 @@ private:
     bool flip;
 
     const BodyAction* action;
-    std::string action_str;
+    BodyDrawinfo::ActionId action_id;
     std::uint8_t act_frame;
 
     const Body* body;
@@ -102,6 +110,10 @@ private:
 
     TimedBool alerted;
 
+    //! Images of every pose drawn, keyed by stance, frame, expression and
+    //! expression frame. Cleared when the look changes.
+    mutable CompositeCache composites;
+
     static BodyDrawinfo draw_info;
     static std::unordered_map<std::int32_t, Hair> hair_styles;
     static std::unordered_map<std::int32_t, Face> face_types;
@@ -103,6 +103,7 @@ Clothing::Clothing(std::int32_t id, const BodyDrawinfo& drawinfo) : item_id(id)
         break;
     }
 
+    FrameTable<Texture>::Builder textures;
     for (auto iter : Stance::names) {
         Stance::Id stance = iter.first;
         const std::string& stancename = iter.second;
@@ -112,9 +113,8 @@ Clothing::Clothing(std::int32_t id, const BodyDrawinfo& drawinfo) : item_id(id)
             continue;
         }
 
-        for (std::uint8_t frame = 0;;
-             ++frame) {
-                 WzNode framenode = stancenode[frame];
+        for (std::uint8_t frame : BodyDrawinfo::get_frames(stancenode)) {
+            WzNode framenode = stancenode[frame];
             for (auto s_partnode = framenode.begin() ; s_partnode!= framenode.end() ; ++s_partnode) {
                 WzNode partnode = (*s_partnode).second;
                 std::string part = partnode.name();
@@ -178,13 +178,13 @@ Clothing::Clothing(std::int32_t id, const BodyDrawinfo& drawinfo) : item_id(id)
                     break;
                 }
 
-                stances[stance][z]
-                    .emplace(frame, partnode)
-                    ->second.shift(shift);
+                textures.add(slot(stance, z), frame, partnode).shift(shift);
             }
         }
     }
 
+    stances = textures.build(Stance::LENGTH * NUM_LAYERS);
+
     static const std::unordered_set<std::int32_t> transparents = {1002186};
     transparent = transparents.count(item_id) > 0;
 }
@@ -194,15 +194,15 @@ void Clothing::draw(Stance::Id stance,
                     std::uint8_t frame,
                     const DrawArgument& args) const
 {
-    auto range = stances[stance][layer].equal_range(frame);
-    for (auto iter = range.first; iter != range.second; ++iter) {
-        iter->second.draw(args);
+    auto [first, last] = stances.range(slot(stance, layer), frame);
+    for (const Texture* texture = first; texture != last; ++texture) {
+        texture->draw(args);
     }
 }
 
 bool Clothing::contains_layer(Stance::Id stance, Layer layer) const noexcept
 {
-    return !stances[stance][layer].empty();
+    return stances.frames(slot(stance, layer)) > 0;
 }
 
 bool Clothing::is_transparent() const noexcept
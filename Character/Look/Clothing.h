@@ -17,7 +17,6 @@
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../Graphics/Texture.h"
-#include "../../Template/EnumMap.h"
 #include "BodyDrawInfo.h"
 #include "EquipSlot.h"
 
@@ -94,11 +93,14 @@ public:
     [[nodiscard]] std::string_view get_vslot() const noexcept;
 
 private:
-    EnumMap<Stance::Id,
-            EnumMap<Layer,
-                    std::unordered_multimap<std::uint8_t, Texture>,
-                    NUM_LAYERS>>
-        stances;
+    static std::size_t slot(Stance::Id stance, Layer layer) noexcept
+    {
+        return static_cast<std::size_t>(stance) * NUM_LAYERS + layer;
+    }
+
+    //! Indexed by stance and layer, see `slot()`. A frame may have several
+    //! textures on the same layer.
+    FrameTable<Texture> stances;
     std::int32_t item_id;
     Equipslot::Id equip_slot;
     Stance::Id walk;
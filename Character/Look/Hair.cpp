@@ -28,6 +28,7 @@ Hair::Hair(std::int32_t hairid, const BodyDrawinfo& drawinfo)
     WzNode hairnode = WzFile::character["Hair"][str::concat(
         "000", std::to_string(hairid), ".img")];
 
+    FrameTable<Texture>::Builder textures;
     for (const auto& s : Stance::names) {
         auto stance = s.first;
         auto stance_name = s.second;
@@ -37,8 +38,7 @@ Hair::Hair(std::int32_t hairid, const BodyDrawinfo& drawinfo)
             continue;
         }
 
-        for (std::uint8_t frame = 0; ;
-             ++frame) {
+        for (std::uint8_t frame : BodyDrawinfo::get_frames(stancenode)) {
             WzNode framenode = stancenode[frame];
             for (auto s_layernode  = framenode.begin() ; s_layernode != framenode.end() ; ++s_layernode) {
                 WzNode layernode = (*s_layernode).second;
@@ -55,13 +55,14 @@ Hair::Hair(std::int32_t hairid, const BodyDrawinfo& drawinfo)
                 Point<std::int16_t> shift
                     = drawinfo.get_hair_pos(stance, frame) - brow;
 
-                stances[stance][layer]
-                    .emplace(frame, layernode)
-                    .first->second.shift(shift);
+                textures.add(slot(stance, layer), frame, layernode)
+                    .shift(shift);
             }
         }
     }
 
+    stances = textures.build(Stance::LENGTH * NUM_LAYERS);
+
     name = WzFile::string["Eqp.img"]["Eqp"]["Hair"][std::to_string(hairid)]
                          ["name"]
                              .getString();
@@ -84,12 +85,9 @@ void Hair::draw(Stance::Id stance,
                 std::uint8_t frame,
                 const DrawArgument& args) const
 {
-    auto frameit = stances[stance][layer].find(frame);
-    if (frameit == stances[stance][layer].end()) {
-        return;
+    if (const Texture* texture = stances.find(slot(stance, layer), frame)) {
+        texture->draw(args);
     }
-
-    frameit->second.draw(args);
 }
 
 std::string_view Hair::get_name() const noexcept
@@ -46,8 +46,13 @@ public:
     [[nodiscard]] std::string_view get_color() const noexcept;
 
 private:
-    std::unordered_map<std::uint8_t, Texture> stances[Stance::LENGTH]
-                                                     [Layer::NUM_LAYERS];
+    static std::size_t slot(Stance::Id stance, Layer layer) noexcept
+    {
+        return static_cast<std::size_t>(stance) * NUM_LAYERS + layer;
+    }
+
+    //! Indexed by stance and layer, see `slot()`.
+    FrameTable<Texture> stances;
     std::string name;
     std::string color;
 
@@ -71,6 +71,44 @@ void Configuration::load() noexcept(false)
                 "No valid value for \"settings.toml:network.port\" found; "
                 "using default.");
         }
+
+        if (auto capture = network_table->get_as<std::string>("capture");
+            capture) {
+            network.capture = *capture;
+        } else {
+            Console::get().print(
+                "No valid value for \"settings.toml:network.capture\" found; "
+                "using default.");
+        }
+
+        if (auto replay = network_table->get_as<std::string>("replay");
+            replay) {
+            network.replay = *replay;
+        } else {
+            Console::get().print(
+                "No valid value for \"settings.toml:network.replay\" found; "
+                "using default.");
+        }
+
+        if (auto replay_realtime
+            = network_table->get_as<bool>("replay_realtime");
+            replay_realtime) {
+            network.replay_realtime = *replay_realtime;
+        } else {
+            Console::get().print(
+                "No valid value for \"settings.toml:network.replay_realtime\" "
+                "found; using default.");
+        }
+
+        if (auto dispatch_budget
+            = network_table->get_as<std::int64_t>("dispatch_budget");
+            dispatch_budget) {
+            network.dispatch_budget = *dispatch_budget;
+        } else {
+            Console::get().print(
+                "No valid value for \"settings.toml:network.dispatch_budget\" "
+                "found; using default.");
+        }
     } else {
         Console::get().print(
             "No valid table \"settings.toml:network\" found; using default.");
@@ -102,6 +140,27 @@ void Configuration::load() noexcept(false)
                 "No valid value for \"settings.toml:video.low_quality\" "
                 "found; using default.");
         }
+
+        if (auto legacy_renderer
+            = video_table->get_as<bool>("legacy_renderer");
+            legacy_renderer) {
+            video.legacy_renderer = *legacy_renderer;
+        } else {
+            Console::get().print(
+                "No valid value for \"settings.toml:video.legacy_renderer\" "
+                "found; using default.");
+        }
+
+        if (auto composite_characters
+            = video_table->get_as<bool>("composite_characters");
+            composite_characters) {
+            video.composite_characters = *composite_characters;
+        } else {
+            Console::get().print(
+                "No valid value for "
+                "\"settings.toml:video.composite_characters\" found; using "
+                "default.");
+        }
     } else {
         Console::get().print(
             "No valid table \"settings.toml:video\" found; using default.");
@@ -711,11 +770,17 @@ void Configuration::save() const noexcept
 [network]
 ip = $
 port = $
+capture = $
+replay = $
+replay_realtime = $
+dispatch_budget = $
 
 [video]
 fullscreen = $
 vsync = $
 low_quality = $
+legacy_renderer = $
+composite_characters = $
 
 [fonts]
 normal = $
@@ -801,81 +866,99 @@ simple_minimap = $
                 write(network.port);
                 break;
             case 2:
-                write(video.fullscreen);
+                write(network.capture);
                 break;
             case 3:
-                write(video.vsync);
+                write(network.replay);
                 break;
             case 4:
-                write(video.low_quality);
+                write(network.replay_realtime);
                 break;
             case 5:
-                write(fonts.normal);
+                write(network.dispatch_budget);
                 break;
             case 6:
-                write(fonts.bold);
+                write(video.fullscreen);
                 break;
             case 7:
-                write(audio.sound_effects);
+                write(video.vsync);
                 break;
             case 8:
-                write(audio.music);
+                write(video.low_quality);
                 break;
             case 9:
-                write(audio.volume.sound_effects);
+                write(video.legacy_renderer);
                 break;
             case 10:
-                write(audio.volume.music);
+                write(video.composite_characters);
                 break;
             case 11:
-                write(account.save_login);
+                write(fonts.normal);
                 break;
             case 12:
-                write(account.account_name);
+                write(fonts.bold);
                 break;
             case 13:
-                write(account.world);
+                write(audio.sound_effects);
                 break;
             case 14:
-                write(account.channel);
+                write(audio.music);
                 break;
             case 15:
-                write(account.character);
+                write(audio.volume.sound_effects);
                 break;
             case 16:
-                write(ui.hp_alert);
+                write(audio.volume.music);
                 break;
             case 17:
-                write(ui.mp_alert);
+                write(account.save_login);
                 break;
             case 18:
-                write(ui.shake_screen);
+                write(account.account_name);
                 break;
             case 19:
-                write(ui.simple_minimap);
+                write(account.world);
                 break;
             case 20:
-                write(ui.position.key_config);
+                write(account.channel);
                 break;
             case 21:
-                write(ui.position.stats);
+                write(account.character);
                 break;
             case 22:
-                write(ui.position.inventory);
+                write(ui.hp_alert);
                 break;
             case 23:
-                write(ui.position.equip_inventory);
+                write(ui.mp_alert);
                 break;
             case 24:
-                write(ui.position.skillbook);
+                write(ui.shake_screen);
                 break;
             case 25:
-                write(ui.position.change_channel);
+                write(ui.simple_minimap);
                 break;
             case 26:
-                write(ui.position.game_settings);
+                write(ui.position.key_config);
                 break;
             case 27:
+                write(ui.position.stats);
+                break;
+            case 28:
+                write(ui.position.inventory);
+                break;
+            case 29:
+                write(ui.position.equip_inventory);
+                break;
+            case 30:
+                write(ui.position.skillbook);
+                break;
+            case 31:
+                write(ui.position.change_channel);
+                break;
+            case 32:
+                write(ui.position.game_settings);
+                break;
+            case 33:
                 write(ui.position.system_settings);
                 break;
             default:
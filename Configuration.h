@@ -87,12 +87,28 @@ struct Configuration : public Singleton<Configuration> {
     struct Network {
         std::string ip = "127.0.0.1";
         std::uint16_t port = 8484;
+        //! Record all inbound packets to this file, if not empty.
+        std::string capture;
+        //! Replay the packets logged in this file instead of connecting to
+        //! the server, if not empty.
+        std::string replay;
+        //! Replay packets with their original timing rather than as fast as
+        //! they can be handled.
+        bool replay_realtime = true;
+        //! Microseconds which may be spent handling received packets per
+        //! frame.
+        std::int64_t dispatch_budget = 4'000;
     };
 
     struct Video {
         bool fullscreen = false;
         bool vsync = true;
         bool low_quality = false;
+        //! Use the OpenGL 2.1 renderer even if OpenGL 3.3 is available.
+        bool legacy_renderer = false;
+        //! Draw the layers of each character as one image, rendered once
+        //! for every pose.
+        bool composite_characters = true;
     };
 
     struct Fonts {
@@ -0,0 +1,123 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "MobData.h"
+
+#include "../Util/Misc.h"
+#include "Wz.h"
+
+namespace jrc
+{
+MobData::MobData(std::int32_t mob_id) : id(mob_id)
+{
+    std::string strid = string_format::extend_id(mob_id, 7);
+    WzNode src = WzFile::mob[strid + ".img"];
+
+    WzNode info = src["info"];
+
+    stats.level = info["level"];
+    stats.watk = info["PADamage"];
+    stats.matk = info["MADamage"];
+    stats.wdef = info["PDDamage"];
+    stats.mdef = info["MDDamage"];
+    stats.accuracy = info["acc"];
+    stats.avoid = info["eva"];
+    stats.knockback = info["pushed"];
+    stats.speed = info["speed"];
+    stats.fly_speed = info["flySpeed"];
+    stats.touch_damage = info["bodyAttack"].getBoolean();
+    stats.undead = info["undead"].getBoolean();
+    stats.no_flip = info["noFlip"].getBoolean();
+    stats.not_attack = info["notAttack"].getBoolean();
+    stats.can_jump = src["jump"].getSize() > 0;
+    stats.can_fly = src["fly"].getSize() > 0;
+    stats.can_move = src["move"].getSize() > 0 || stats.can_fly;
+
+    stats.speed += 100;
+    stats.speed *= 0.001f;
+
+    stats.fly_speed += 100;
+    stats.fly_speed *= 0.0005f;
+
+    if (stats.can_fly) {
+        animations["stand"] = src["fly"];
+        animations["move"] = src["fly"];
+    } else {
+        animations["stand"] = src["stand"];
+        animations["move"] = src["move"];
+    }
+    animations["jump"] = src["jump"];
+    animations["hit1"] = src["hit1"];
+    animations["die1"] = src["die1"];
+
+    name = WzFile::string["Mob.img"][std::to_string(mob_id)]["name"]
+               .getString();
+
+    WzNode sndsrc = WzFile::sound["Mob.img"][strid];
+
+    hit_sound = sndsrc["Damage"];
+    die_sound = sndsrc["Die"];
+
+    valid = info.getSize() > 0;
+}
+
+bool MobData::is_valid() const noexcept
+{
+    return valid;
+}
+
+MobData::operator bool() const noexcept
+{
+    return is_valid();
+}
+
+std::int32_t MobData::get_id() const noexcept
+{
+    return id;
+}
+
+const MobData::Stats& MobData::get_stats() const noexcept
+{
+    return stats;
+}
+
+std::string_view MobData::get_name() const noexcept
+{
+    return name;
+}
+
+const Animation& MobData::get_animation(std::string_view stance) const
+    noexcept
+{
+    if (auto iter = animations.find(std::string{stance});
+        iter != animations.end()) {
+        return iter->second;
+    }
+
+    return null_animation;
+}
+
+WzNode MobData::get_hit_sound() const noexcept
+{
+    return hit_sound;
+}
+
+WzNode MobData::get_die_sound() const noexcept
+{
+    return die_sound;
+}
+} // namespace jrc
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../Graphics/Animation.h"
+#include "../Template/Cache.h"
+#include "WzNode.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace jrc
+{
+//! Information about a monster which is shared by every mob with the same id.
+//! Loaded once per id, so that spawning a mob does not parse the game files.
+class MobData : public Cache<MobData>
+{
+public:
+    //! Stats of the monster, read from its `info` node.
+    struct Stats {
+        std::uint16_t level;
+        float speed;
+        float fly_speed;
+        std::uint16_t watk;
+        std::uint16_t matk;
+        std::uint16_t wdef;
+        std::uint16_t mdef;
+        std::uint16_t accuracy;
+        std::uint16_t avoid;
+        std::uint16_t knockback;
+        bool undead;
+        bool touch_damage;
+        bool no_flip;
+        bool not_attack;
+        bool can_move;
+        bool can_jump;
+        bool can_fly;
+    };
+
+    //! Returns wether the mob was loaded correctly.
+    [[nodiscard]] bool is_valid() const noexcept;
+    //! Returns wether the mob was loaded correctly.
+    explicit operator bool() const noexcept;
+
+    //! Returns the mob id.
+    [[nodiscard]] std::int32_t get_id() const noexcept;
+    //! Returns the mob's stats.
+    [[nodiscard]] const Stats& get_stats() const noexcept;
+    //! Returns the mob's name loaded from the String.wz file.
+    [[nodiscard]] std::string_view get_name() const noexcept;
+    //! Returns the animation for a stance, by the name of its node.
+    //!
+    //! If the mob has no such stance, an empty animation is returned.
+    [[nodiscard]] const Animation&
+    get_animation(std::string_view stance) const noexcept;
+    //! Returns the node of the sound played when the mob is hit.
+    //!
+    //! Sounds are created by each mob rather than kept here, so that their
+    //! samples can be freed when the map is cleared.
+    [[nodiscard]] WzNode get_hit_sound() const noexcept;
+    //! Returns the node of the sound played when the mob dies.
+    [[nodiscard]] WzNode get_die_sound() const noexcept;
+
+private:
+    //! Allow the cache to use the constructor.
+    friend Cache<MobData>;
+    //! Load a mob from the game files.
+    MobData(std::int32_t mob_id);
+
+    std::unordered_map<std::string, Animation> animations;
+    Animation null_animation;
+    std::string name;
+    WzNode hit_sound;
+    WzNode die_sound;
+    Stats stats;
+    std::int32_t id;
+
+    bool valid;
+};
+} // namespace jrc
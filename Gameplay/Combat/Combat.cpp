@@ -77,6 +77,13 @@ void Combat::update()
                        damage_numbers.end(),
                        [](DamageNumber& dn) { return dn.update(); }),
         damage_numbers.end());
+
+    // Build one queued skill per tick, so that preparing many skills never
+    // stalls a single frame.
+    if (!prewarm_queue.empty()) {
+        Skill::get(prewarm_queue.back());
+        prewarm_queue.pop_back();
+    }
 }
 
 void Combat::use_move(std::int32_t move_id)
@@ -323,16 +330,18 @@ void Combat::show_player_buff(std::int32_t skill_id)
     get_move(skill_id).apply_useeffects(player);
 }
 
+void Combat::prewarm(const std::vector<std::int32_t>& skill_ids)
+{
+    prewarm_queue.insert(
+        prewarm_queue.end(), skill_ids.begin(), skill_ids.end());
+}
+
 const SpecialMove& Combat::get_move(std::int32_t move_id)
 {
     if (move_id == 0) {
         return regular_attack;
     }
 
-    auto iter = skills.find(move_id);
-    if (iter == skills.end()) {
-        iter = skills.emplace(move_id, move_id).first;
-    }
-    return iter->second;
+    return Skill::get(move_id);
 }
 } // namespace jrc
@@ -24,6 +24,8 @@
 #include "RegularAttack.h"
 #include "Skill.h"
 
+#include <vector>
+
 namespace jrc
 {
 class Combat
@@ -46,6 +48,10 @@ public:
     //! Show a buff effect.
     void show_player_buff(std::int32_t skill_id);
 
+    //! Queue the definitions of the specified skills to be built over the
+    //! next updates, so that their first use does not stall the game.
+    void prewarm(const std::vector<std::int32_t>& skill_ids);
+
 private:
     struct DamageEffect {
         AttackUser user;
@@ -82,8 +88,9 @@ private:
     MapChars& chars;
     MapMobs& mobs;
 
-    std::unordered_map<std::int32_t, Skill> skills;
     RegularAttack regular_attack;
+    //! Skills still to be built by `update()`.
+    std::vector<std::int32_t> prewarm_queue;
 
     TimedQueue<AttackResult> attack_results;
     TimedQueue<BulletEffect> bullet_effects;
@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "../../Template/Cache.h"
 #include "SkillAction.h"
 #include "SkillBullet.h"
 #include "SkillHitEffect.h"
@@ -28,11 +29,12 @@
 namespace jrc
 {
 // The skill implementation of special move.
-class Skill : public SpecialMove
+//
+// Definitions are shared by all characters through the cache, and may be
+// built ahead of their first use.
+class Skill : public SpecialMove, public Cache<Skill>
 {
 public:
-    Skill(std::int32_t skillid);
-
     void apply_useeffects(Char& user) const override;
     void apply_actions(Char& user, Attack::Type type) const override;
     void apply_stats(const Char& user, Attack& attack) const override;
@@ -52,6 +54,10 @@ public:
                          std::uint16_t bullets) const override;
 
 private:
+    Skill(std::int32_t skillid);
+
+    friend Cache<Skill>;
+
     std::unique_ptr<SkillAction> action;
     std::unique_ptr<SkillBullet> bullet;
     std::unique_ptr<SkillSound> sound;
@@ -0,0 +1,47 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "MapLoader.h"
+
+#include "../Util/Misc.h"
+#include "Wz.h"
+
+#include <string>
+
+namespace jrc
+{
+MapLoader::MapData MapLoader::load(std::int32_t map_id)
+{
+    std::string str_id = string_format::extend_id(map_id, 9);
+    str_id += ".img";
+
+    WzNode src
+        = WzFile::map["Map"]["Map" + std::to_string(map_id / 100'000'000)]
+                     [str_id];
+
+    MapData data;
+    data.tiles_objs = MapTilesObjs(src);
+    data.backgrounds = MapBackgrounds(src["back"]);
+    data.physics = Physics(src["foothold"]);
+    data.map_info = {src,
+                     data.physics.get_fht().get_walls(),
+                     data.physics.get_fht().get_borders()};
+    data.portals = MapPortals(src["portal"], map_id);
+
+    return data;
+}
+} // namespace jrc
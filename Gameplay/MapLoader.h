@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "MapleMap/MapBackgrounds.h"
+#include "MapleMap/MapInfo.h"
+#include "MapleMap/MapPortals.h"
+#include "MapleMap/MapTilesObjs.h"
+#include "Physics/Physics.h"
+
+#include <cstdint>
+
+namespace jrc
+{
+//! Builds the static parts of a map from game data.
+//!
+//! Loading happens on the calling thread, as game data nodes are parsed
+//! lazily and may not be read from two threads at once.
+class MapLoader
+{
+public:
+    //! The static parts of a map.
+    struct MapData {
+        MapInfo map_info;
+        MapTilesObjs tiles_objs;
+        MapBackgrounds backgrounds;
+        Physics physics;
+        MapPortals portals;
+    };
+
+    //! Return the data for the specified map.
+    static MapData load(std::int32_t map_id);
+};
+} // namespace jrc
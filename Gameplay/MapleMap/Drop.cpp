@@ -59,10 +59,8 @@ Drop::Drop(std::int32_t id,
     }
 }
 
-std::int8_t Drop::update(const Physics& physics)
+std::int8_t Drop::update(const Physics&)
 {
-    physics.move_object(ph_obj);
-
     if (state == DROPPED) {
         if (ph_obj.on_ground) {
             ph_obj.hspeed = 0.0;
@@ -128,4 +126,9 @@ Rectangle<std::int16_t> Drop::bounds() const
     auto rb = lt + Point<std::int16_t>(32, 32);
     return Rectangle<std::int16_t>(lt, rb);
 }
+
+Rectangle<std::int16_t> Drop::get_bounds() const
+{
+    return bounds();
+}
 } // namespace jrc
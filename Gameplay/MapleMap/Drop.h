@@ -31,6 +31,7 @@ public:
     void expire(std::int8_t, const PhysicsObject*);
 
     Rectangle<std::int16_t> bounds() const;
+    Rectangle<std::int16_t> get_bounds() const override;
 
 protected:
     Drop(std::int32_t oid,
@@ -108,15 +108,15 @@ MapDrops::Loot MapDrops::find_loot_at(Point<std::int16_t> playerpos)
     if (!lootenabled)
         return {0, {}};
 
-    for (auto& mmo : drops) {
-        nullable_ptr<const Drop> drop = mmo.second.get();
-        if (drop && drop->bounds().contains(playerpos)) {
-            lootenabled = false;
-
-            std::int32_t oid = mmo.first;
-            Point<std::int16_t> position = drop->get_position();
-            return {oid, position};
-        }
+    nullable_ptr<const MapObject> drop
+        = drops.find_at(playerpos, [playerpos](const MapObject& mmo) {
+              return mmo.get_bounds().contains(playerpos);
+          });
+
+    if (drop) {
+        lootenabled = false;
+
+        return {drop->get_oid(), drop->get_position()};
     }
     return {0, {}};
 }
@@ -146,7 +146,7 @@ void MapMobs::apply_damage(std::int32_t oid,
     }
 }
 
-boost::container::flat_map<std::uint16_t, std::int32_t>
+std::vector<std::pair<std::uint16_t, std::int32_t>>
 MapMobs::find_closest(Rectangle<std::int16_t> range,
                       Point<std::int16_t> origin,
                       std::uint8_t mob_count) const noexcept
@@ -154,47 +154,22 @@ MapMobs::find_closest(Rectangle<std::int16_t> range,
     if (mob_count == 0) {
         return {};
     }
-    if (mob_count == 1) {
-        auto closest_oid = std::numeric_limits<std::int32_t>::lowest();
-        auto closest_distance = std::numeric_limits<std::uint16_t>::max();
-        for (const auto& mmo : mobs) {
-            auto mob = static_cast<const Mob*>(mmo.second.get());
-            if (mob && mob->is_alive() && mob->is_in_range(range)) {
-                std::int32_t oid = mob->get_oid();
-                auto distance = static_cast<std::uint16_t>(
-                    mob->get_position().disp(origin));
 
-                if (distance < closest_distance) {
-                    closest_distance = distance;
-                    closest_oid = oid;
-                }
-            }
-        }
-
-        if (closest_oid == std::numeric_limits<std::int32_t>::lowest()) {
-            return {};
-        } else {
-            return {{{closest_distance, closest_oid}}};
-        }
-    }
-
-    boost::container::flat_map<std::uint16_t, std::int32_t> targets;
-    targets.reserve(mob_count + 1);
-
-    for (const auto& mmo : mobs) {
-        auto mob = static_cast<const Mob*>(mmo.second.get());
-        if (mob && mob->is_alive() && mob->is_in_range(range)) {
-            std::int32_t oid = mob->get_oid();
-            auto distance
-                = static_cast<std::uint16_t>(mob->get_position().disp(origin));
-            targets.emplace(distance, oid);
-
-            if (targets.size() > mob_count) {
-                auto furthest = targets.end();
-                --furthest;
-                targets.erase(furthest);
-            }
-        }
+    auto in_range = [&range](const MapObject& mmo) {
+        const auto& mob = static_cast<const Mob&>(mmo);
+        return mob.is_alive() && mob.is_in_range(range);
+    };
+
+    // Already ordered by distance, so a sorted vector keeps mobs at equal
+    // distances, which a map keyed by distance would collapse.
+    std::vector<std::pair<std::uint16_t, std::int32_t>> targets;
+    targets.reserve(mob_count);
+
+    for (const MapObject* mob :
+         mobs.find_nearest(range, origin, mob_count, in_range)) {
+        auto distance
+            = static_cast<std::uint16_t>(mob->get_position().disp(origin));
+        targets.emplace_back(distance, mob->get_oid());
     }
 
     return targets;
@@ -215,17 +190,17 @@ std::int32_t MapMobs::find_colliding(const MovingObject& moveobj) const
                                             - static_cast<std::int16_t>(50),
                                         vertical.greater()};
 
-    auto iter
-        = std::find_if(mobs.begin(), mobs.end(), [player_rect](auto& mmo) {
-              nullable_ptr<Mob> mob = mmo.second.get();
-              return mob && mob->is_alive() && mob->is_in_range(player_rect);
+    nullable_ptr<const MapObject> colliding
+        = mobs.find_in(player_rect, [&player_rect](const MapObject& mmo) {
+              const auto& mob = static_cast<const Mob&>(mmo);
+              return mob.is_alive() && mob.is_in_range(player_rect);
           });
 
-    if (iter == mobs.end()) {
+    if (!colliding) {
         return 0;
     }
 
-    return iter->second->get_oid();
+    return colliding->get_oid();
 }
 
 MobAttack MapMobs::create_attack(std::int32_t oid) const
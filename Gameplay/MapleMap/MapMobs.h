@@ -20,9 +20,10 @@
 #include "../Combat/SpecialMove.h"
 #include "../Spawn.h"
 #include "MapObjects.h"
-#include "boost/container/flat_map.hpp"
 
 #include <queue>
+#include <utility>
+#include <vector>
 
 namespace jrc
 {
@@ -74,7 +75,9 @@ public:
     Point<std::int16_t> get_mob_head_position(std::int32_t oid) const;
 
 private:
-    [[nodiscard]] boost::container::flat_map<std::uint16_t, std::int32_t>
+    //! Return the distances and ids of up to `mob_count` mobs in range,
+    //! closest first. Mobs at equal distances are all kept.
+    [[nodiscard]] std::vector<std::pair<std::uint16_t, std::int32_t>>
     find_closest(Rectangle<std::int16_t> range,
                  Point<std::int16_t> origin,
                  std::uint8_t mob_count) const noexcept;
@@ -67,16 +67,20 @@ Cursor::State MapNpcs::send_cursor(bool pressed,
                                    Point<std::int16_t> position,
                                    Point<std::int16_t> viewpos)
 {
-    for (auto& mmo : npcs) {
-        Npc* npc = static_cast<Npc*>(mmo.second.get());
-        if (npc && npc->is_active() && npc->in_range(position, viewpos)) {
-            if (pressed) {
-                // TODO: try finding dialogue first
-                TalkToNPCPacket(npc->get_oid()).dispatch();
-                return Cursor::IDLE;
-            } else {
-                return Cursor::CAN_CLICK;
-            }
+    // The cursor is in screen coordinates, npcs are indexed in map
+    // coordinates.
+    nullable_ptr<const MapObject> npc = npcs.find_at(
+        position - viewpos, [position, viewpos](const MapObject& mmo) {
+            return static_cast<const Npc&>(mmo).in_range(position, viewpos);
+        });
+
+    if (npc) {
+        if (pressed) {
+            // TODO: try finding dialogue first
+            TalkToNPCPacket(npc->get_oid()).dispatch();
+            return Cursor::IDLE;
+        } else {
+            return Cursor::CAN_CLICK;
         }
     }
     return Cursor::IDLE;
@@ -25,9 +25,13 @@ MapObject::MapObject(std::int32_t o, Point<std::int16_t> p) : oid(o)
     active = true;
 }
 
-std::int8_t MapObject::update(const Physics& physics)
+PhysicsObject* MapObject::prepare_physics()
+{
+    return &ph_obj;
+}
+
+std::int8_t MapObject::update(const Physics&)
 {
-    physics.move_object(ph_obj);
     return ph_obj.fh_layer;
 }
 
@@ -73,4 +77,10 @@ Point<std::int16_t> MapObject::get_position() const
 {
     return ph_obj.get_position();
 }
+
+Rectangle<std::int16_t> MapObject::get_bounds() const
+{
+    Point<std::int16_t> position = get_position();
+    return {position, position};
+}
 } // namespace jrc
@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "../../Template/Rectangle.h"
 #include "../Camera.h"
 #include "../Physics/Physics.h"
 
@@ -31,6 +32,10 @@ public:
     //! interpolation.
     virtual void draw(double viewx, double viewy, float alpha) const = 0;
 
+    //! Prepares the object for the next physics step. Returns the physics
+    //! object to move, or `nullptr` if the object should not be moved.
+    //! Called for every object of a collection before `update`.
+    virtual PhysicsObject* prepare_physics();
     //! Updates the object and returns the updated layer.
     virtual std::int8_t update(const Physics& physics);
     //! Reactivates the object.
@@ -51,6 +56,8 @@ public:
     std::int32_t get_oid() const;
     //! Returns the current position.
     Point<std::int16_t> get_position() const;
+    //! Returns the area covered by the object, in map coordinates.
+    virtual Rectangle<std::int16_t> get_bounds() const;
 
 protected:
     MapObject(std::int32_t oid, Point<std::int16_t> position = {});
@@ -34,6 +34,17 @@ void MapObjects::draw(Layer::Id layer,
 
 void MapObjects::update(const Physics& physics)
 {
+    moving.clear();
+    for (auto& iter : objects) {
+        if (auto& mmo = iter.second) {
+            if (PhysicsObject* phobj = mmo->prepare_physics()) {
+                moving.push_back(phobj);
+            }
+        }
+    }
+
+    physics.move_objects(moving.data(), moving.size());
+
     for (auto iter = objects.begin(); iter != objects.end();) {
         bool remove_mob = false;
         if (auto& mmo = iter->second) {
@@ -41,16 +52,21 @@ void MapObjects::update(const Physics& physics)
             std::int8_t newlayer = mmo->update(physics);
             if (newlayer == -1) {
                 remove_mob = true;
-            } else if (newlayer != oldlayer) {
-                std::int32_t oid = iter->first;
-                layers[oldlayer].erase(oid);
-                layers[newlayer].insert(oid);
+            } else {
+                if (newlayer != oldlayer) {
+                    std::int32_t oid = iter->first;
+                    layers[oldlayer].erase(oid);
+                    layers[newlayer].insert(oid);
+                }
+
+                grid.update(mmo.get());
             }
         } else {
             remove_mob = true;
         }
 
         if (remove_mob) {
+            grid.remove(iter->second.get());
             iter = objects.erase(iter);
         } else {
             ++iter;
@@ -61,6 +77,7 @@ void MapObjects::update(const Physics& physics)
 void MapObjects::clear()
 {
     objects.clear();
+    grid.clear();
 
     for (auto& layer : layers) {
         layer.clear();
@@ -76,7 +93,14 @@ void MapObjects::add(std::unique_ptr<MapObject> toadd)
 {
     std::int32_t oid = toadd->get_oid();
     std::int8_t layer = toadd->get_layer();
-    objects[oid] = std::move(toadd);
+    grid.update(toadd.get());
+
+    auto& slot = objects[oid];
+    if (slot) {
+        grid.remove(slot.get());
+    }
+
+    slot = std::move(toadd);
     layers[layer].insert(oid);
 }
 
@@ -85,6 +109,7 @@ void MapObjects::remove(std::int32_t oid)
     auto iter = objects.find(oid);
     if (iter != objects.end() && iter->second) {
         std::int8_t layer = iter->second->get_layer();
+        grid.remove(iter->second.get());
         objects.erase(iter);
 
         layers[layer].erase(oid);
@@ -19,11 +19,14 @@
 #include "../../Template/nullable_ptr.h"
 #include "Layer.h"
 #include "MapObject.h"
+#include "SpatialGrid.h"
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace jrc
 {
@@ -53,6 +56,72 @@ public:
     //! Number of mapobjects in this collection.
     [[nodiscard]] std::size_t size() const noexcept;
 
+    template<typename Predicate>
+    //! Return the first object near the area which satisfies the predicate.
+    //! Objects are indexed by their position after the last update, so the
+    //! predicate should perform the exact check.
+    nullable_ptr<const MapObject> find_in(const Rectangle<std::int16_t>& area,
+                                          Predicate&& predicate) const
+    {
+        const MapObject* found = nullptr;
+        grid.query(area, [&](const MapObject& mmo) {
+            if (predicate(mmo)) {
+                found = &mmo;
+                return true;
+            }
+
+            return false;
+        });
+
+        return found;
+    }
+
+    template<typename Predicate>
+    //! Return the first object near the point which satisfies the predicate.
+    nullable_ptr<const MapObject> find_at(Point<std::int16_t> point,
+                                          Predicate&& predicate) const
+    {
+        return find_in({point, point}, std::forward<Predicate>(predicate));
+    }
+
+    template<typename Predicate>
+    //! Return up to `count` objects near the area which satisfy the
+    //! predicate, ordered by their distance to `origin`.
+    std::vector<const MapObject*>
+    find_nearest(const Rectangle<std::int16_t>& area,
+                 Point<std::int16_t> origin,
+                 std::size_t count,
+                 Predicate&& predicate) const
+    {
+        std::vector<std::pair<std::int32_t, const MapObject*>> candidates;
+        grid.query(area, [&](const MapObject& mmo) {
+            if (predicate(mmo)) {
+                Point<std::int16_t> delta = mmo.get_position() - origin;
+                std::int32_t distance = delta.x() * delta.x()
+                                        + delta.y() * delta.y();
+                candidates.emplace_back(distance, &mmo);
+            }
+
+            return false;
+        });
+
+        count = std::min(count, candidates.size());
+        std::partial_sort(candidates.begin(),
+                          candidates.begin() + count,
+                          candidates.end(),
+                          [](const auto& a, const auto& b) {
+                              return a.first < b.first;
+                          });
+
+        std::vector<const MapObject*> nearest;
+        nearest.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            nearest.push_back(candidates[i].second);
+        }
+
+        return nearest;
+    }
+
     using underlying_t =
         typename std::unordered_map<std::int32_t, std::unique_ptr<MapObject>>;
     //! Return a begin iterator.
@@ -67,5 +136,8 @@ public:
 private:
     std::unordered_map<std::int32_t, std::unique_ptr<MapObject>> objects;
     std::array<std::unordered_set<std::int32_t>, Layer::LENGTH> layers;
+    SpatialGrid grid;
+    // Scratch list of the objects moved during an update.
+    std::vector<PhysicsObject*> moving;
 };
 } // namespace jrc
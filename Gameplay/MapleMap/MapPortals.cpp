@@ -39,7 +39,12 @@ MapPortals::MapPortals(WzNode src, std::int32_t map_id)
         std::int32_t target_id = sub["tm"];
         Point<std::int16_t> position = {sub["x"], sub["y"]};
 
-        const Animation* animation = &animations[type];
+        // Building a map never inserts into the shared animations; unknown
+        // types are drawn with a blank animation.
+        static const Animation blank;
+        auto anim_iter = animations.find(type);
+        const Animation* animation
+            = anim_iter != animations.end() ? &anim_iter->second : &blank;
         bool intramap = target_id == map_id;
 
         portal_ids_by_name.emplace(std::string{name}, portal_id);
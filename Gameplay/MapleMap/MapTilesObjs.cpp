@@ -54,9 +54,15 @@ void TilesObjs::draw(Point<std::int16_t> view_pos, float alpha) const
         obj.draw(view_pos, alpha);
     }
 
-    for (auto& [_, tile] : tiles) {
-        tile.draw(view_pos);
+    if (!tile_batch.is_recorded()) {
+        tile_batch.record([&]() {
+            for (auto& [_, tile] : tiles) {
+                tile.draw({});
+            }
+        });
     }
+
+    tile_batch.draw(view_pos);
 }
 
 MapTilesObjs::MapTilesObjs(WzNode src)
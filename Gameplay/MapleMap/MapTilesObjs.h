@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "../../Graphics/StaticBatch.h"
 #include "../../Template/EnumMap.h"
 #include "Layer.h"
 #include "Obj.h"
@@ -39,6 +40,8 @@ public:
 private:
     boost::container::flat_multimap<std::uint8_t, Tile> tiles;
     boost::container::flat_multimap<std::uint8_t, Obj> objs;
+    // Tiles never move, so they are recorded on the first draw.
+    mutable StaticBatch tile_batch;
 };
 
 //! The collection of tile and obj layers on a map.
@@ -19,9 +19,7 @@
 
 #include "../../Constants.h"
 #include "../../Net/Packets/GameplayPackets.h"
-#include "../../Util/Misc.h"
 #include "../Movement.h"
-#include "Wz.h"
 
 #include <algorithm>
 #include <functional>
@@ -36,57 +34,17 @@ Mob::Mob(std::int32_t oid,
          bool new_spawn,
          std::int8_t tm,
          Point<std::int16_t> position)
-    : MapObject(oid)
+    : MapObject(oid),
+      data(MobData::get(mob_id)),
+      stats(data.get_stats()),
+      hit_sound(data.get_hit_sound()),
+      die_sound(data.get_die_sound())
 {
-    std::string strid = string_format::extend_id(mob_id, 7);
-    WzNode src = WzFile::mob[strid + ".img"];
-
-    WzNode info = src["info"];
-
-    level = info["level"];
-    watk = info["PADamage"];
-    matk = info["MADamage"];
-    wdef = info["PDDamage"];
-    mdef = info["MDDamage"];
-    accuracy = info["acc"];
-    avoid = info["eva"];
-    knockback = info["pushed"];
-    speed = info["speed"];
-    fly_speed = info["flySpeed"];
-    touch_damage = info["bodyAttack"].getBoolean();
-    undead = info["undead"].getBoolean();
-    no_flip = info["noFlip"].getBoolean();
-    not_attack = info["notAttack"].getBoolean();
-    can_jump = src["jump"].getSize() > 0;
-    can_fly = src["fly"].getSize() > 0;
-    can_move = src["move"].getSize() > 0 || can_fly;
-
-    if (can_fly) {
-        animations[STAND] = src["fly"];
-        animations[MOVE] = src["fly"];
-    } else {
-        animations[STAND] = src["stand"];
-        animations[MOVE] = src["move"];
+    for (Stance st : {MOVE, STAND, JUMP, HIT, DIE}) {
+        animations[st] = data.get_animation(name_of(st));
     }
-    animations[JUMP] = src["jump"];
-    animations[HIT] = src["hit1"];
-    animations[DIE] = src["die1"];
-
-    name = WzFile::string["Mob.img"][std::to_string(mob_id)]["name"]
-               .getString();
-
-    WzNode sndsrc = WzFile::sound["Mob.img"][strid];
-
-    hit_sound = sndsrc["Damage"];
-    die_sound = sndsrc["Die"];
 
-    speed += 100;
-    speed *= 0.001f;
-
-    fly_speed += 100;
-    fly_speed *= 0.0005f;
-
-    if (can_fly) {
+    if (stats.can_fly) {
         ph_obj.type = PhysicsObject::FLYING;
     }
 
@@ -110,7 +68,7 @@ Mob::Mob(std::int32_t oid,
                   Text::CENTER,
                   Text::WHITE,
                   Text::NAMETAG,
-                  std::string{name}};
+                  std::string{data.get_name()}};
 
     if (new_spawn) {
         fade_in = true;
@@ -148,6 +106,57 @@ void Mob::set_stance(Stance newstance)
     }
 }
 
+PhysicsObject* Mob::prepare_physics()
+{
+    if (!active || dying || dead) {
+        return nullptr;
+    }
+
+    if (!stats.can_fly) {
+        if (ph_obj.is_flag_not_set(PhysicsObject::TURN_AT_EDGES)) {
+            flip = !flip;
+            ph_obj.set_flag(PhysicsObject::TURN_AT_EDGES);
+
+            if (stance == HIT) {
+                set_stance(STAND);
+            }
+        }
+    }
+
+    switch (stance) {
+    case MOVE:
+        if (stats.can_fly) {
+            ph_obj.h_force = flip ? stats.fly_speed : -stats.fly_speed;
+            switch (fly_direction) {
+            case UPWARDS:
+                ph_obj.v_force = -stats.fly_speed;
+                break;
+            case DOWNWARDS:
+                ph_obj.v_force = stats.fly_speed;
+                break;
+            default:
+                break;
+            }
+        } else {
+            ph_obj.h_force = flip ? stats.speed : -stats.speed;
+        }
+        break;
+    case HIT:
+        if (stats.can_move) {
+            double KBFORCE = ph_obj.on_ground ? 0.2 : 0.1;
+            ph_obj.h_force = flip ? -KBFORCE : KBFORCE;
+        }
+        break;
+    case JUMP:
+        ph_obj.v_force = -5.0;
+        break;
+    default:
+        break;
+    }
+
+    return &ph_obj;
+}
+
 std::int8_t Mob::update(const Physics& physics)
 {
     if (!active) {
@@ -183,50 +192,6 @@ std::int8_t Mob::update(const Physics& physics)
     do_show_hp.update();
 
     if (!dying) {
-        if (!can_fly) {
-            if (ph_obj.is_flag_not_set(PhysicsObject::TURN_AT_EDGES)) {
-                flip = !flip;
-                ph_obj.set_flag(PhysicsObject::TURN_AT_EDGES);
-
-                if (stance == HIT) {
-                    set_stance(STAND);
-                }
-            }
-        }
-
-        switch (stance) {
-        case MOVE:
-            if (can_fly) {
-                ph_obj.h_force = flip ? fly_speed : -fly_speed;
-                switch (fly_direction) {
-                case UPWARDS:
-                    ph_obj.v_force = -fly_speed;
-                    break;
-                case DOWNWARDS:
-                    ph_obj.v_force = fly_speed;
-                    break;
-                default:
-                    break;
-                }
-            } else {
-                ph_obj.h_force = flip ? speed : -speed;
-            }
-            break;
-        case HIT:
-            if (can_move) {
-                double KBFORCE = ph_obj.on_ground ? 0.2 : 0.1;
-                ph_obj.h_force = flip ? -KBFORCE : KBFORCE;
-            }
-            break;
-        case JUMP:
-            ph_obj.v_force = -5.0;
-            break;
-        default:
-            break;
-        }
-
-        physics.move_object(ph_obj);
-
         if (control) {
             ++counter;
 
@@ -259,7 +224,7 @@ std::int8_t Mob::update(const Physics& physics)
 
 void Mob::next_move()
 {
-    if (can_move) {
+    if (stats.can_move) {
         switch (stance) {
         case HIT:
         case STAND:
@@ -268,7 +233,8 @@ void Mob::next_move()
             break;
         case MOVE:
         case JUMP:
-            if (can_jump && ph_obj.on_ground && Randomizer::below(0.25f)) {
+            if (stats.can_jump && ph_obj.on_ground
+                && Randomizer::below(0.25f)) {
                 set_stance(JUMP);
             } else {
                 switch (Randomizer::next_int(3)) {
@@ -292,7 +258,7 @@ void Mob::next_move()
             break;
         }
 
-        if (stance == MOVE && can_fly) {
+        if (stance == MOVE && stats.can_fly) {
             fly_direction = Randomizer::next_enum(NUM_DIRECTIONS);
         }
     } else {
@@ -326,7 +292,7 @@ void Mob::draw(double viewx, double viewy, float alpha) const
         float interopc = opacity.get(alpha);
 
         animations.at(stance).draw(
-            DrawArgument(absp, flip && !no_flip, interopc), alpha);
+            DrawArgument(absp, flip && !stats.no_flip, interopc), alpha);
 
         if (do_show_hp) {
             name_label.draw(absp);
@@ -372,7 +338,7 @@ void Mob::send_movement(Point<std::int16_t> start,
 Point<std::int16_t> Mob::get_head_position(Point<std::int16_t> position) const
 {
     Point<std::int16_t> head = animations.at(stance).get_head();
-    position.shift_x((flip && !no_flip) ? -head.x() : head.x());
+    position.shift_x((flip && !stats.no_flip) ? -head.x() : head.x());
     position.shift_y(head.y());
 
     return position;
@@ -402,7 +368,7 @@ void Mob::kill(std::int8_t kill_type)
 void Mob::show_hp(std::int8_t percent, std::uint16_t player_level)
 {
     if (hp_percent == 0) {
-        std::int16_t delta = player_level - level;
+        std::int16_t delta = player_level - stats.level;
         if (delta > 9) {
             name_label.change_color(Text::YELLOW);
         } else if (delta < -9) {
@@ -452,7 +418,7 @@ float Mob::calculate_hit_chance(std::int16_t level_delta,
 {
     auto faccuracy = static_cast<float>(player_accuracy);
     float hitchance
-        = faccuracy / (((1.84f + 0.07f * level_delta) * avoid) + 1.0f);
+        = faccuracy / (((1.84f + 0.07f * level_delta) * stats.avoid) + 1.0f);
     if (hitchance < 0.01f) {
         hitchance = 0.01f;
     }
@@ -465,8 +431,8 @@ double Mob::calculate_min_damage(std::int16_t level_delta,
                                  bool magic) const
 {
     double mindamage
-        = magic ? min_damage - (1 + 0.01 * level_delta) * mdef * 0.6
-                : min_damage * (1 - 0.01 * level_delta) - wdef * 0.6;
+        = magic ? min_damage - (1 + 0.01 * level_delta) * stats.mdef * 0.6
+                : min_damage * (1 - 0.01 * level_delta) - stats.wdef * 0.6;
 
     return mindamage < 1.0 ? 1.0 : mindamage;
 }
@@ -476,8 +442,8 @@ double Mob::calculate_max_damage(std::int16_t level_delta,
                                  bool magic) const
 {
     double maxdamage
-        = magic ? max_damage - (1 + 0.01 * level_delta) * mdef * 0.5
-                : max_damage * (1 - 0.01 * level_delta) - wdef * 0.5;
+        = magic ? max_damage - (1 + 0.01 * level_delta) * stats.mdef * 0.5
+                : max_damage * (1 - 0.01 * level_delta) - stats.wdef * 0.5;
 
     return maxdamage < 1.0 ? 1.0 : maxdamage;
 }
@@ -489,7 +455,7 @@ Mob::calculate_damage(const Attack& attack)
     double max_damage;
     float hit_chance;
     float critical;
-    std::int16_t level_delta = level - attack.player_level;
+    std::int16_t level_delta = stats.level - attack.player_level;
     if (level_delta < 0) {
         level_delta = 0;
     }
@@ -558,7 +524,7 @@ void Mob::apply_damage(std::int32_t damage, bool to_left)
 
     if (dying && stance != DIE) {
         apply_death();
-    } else if (control && is_alive() && damage >= knockback) {
+    } else if (control && is_alive() && damage >= stats.knockback) {
         flip = to_left;
         counter = 170;
         set_stance(HIT);
@@ -570,12 +536,12 @@ void Mob::apply_damage(std::int32_t damage, bool to_left)
 
 MobAttack Mob::create_touch_attack() const
 {
-    if (!touch_damage) {
+    if (!stats.touch_damage) {
         return {};
     }
 
-    auto minattack = static_cast<std::int32_t>(watk * 0.8f);
-    std::int32_t maxattack = watk;
+    auto minattack = static_cast<std::int32_t>(stats.watk * 0.8f);
+    std::int32_t maxattack = stats.watk;
     std::int32_t attack = Randomizer::next_int(minattack, maxattack);
     return {attack, get_position(), id, oid};
 }
@@ -598,9 +564,14 @@ bool Mob::is_in_range(const Rectangle<std::int16_t>& range) const
         return false;
     }
 
+    return range.overlaps(get_bounds());
+}
+
+Rectangle<std::int16_t> Mob::get_bounds() const
+{
     Rectangle<std::int16_t> bounds = animations.at(stance).get_bounds();
     bounds.shift(get_position());
-    return range.overlaps(bounds);
+    return bounds;
 }
 
 Point<std::int16_t> Mob::get_head_position() const
@@ -18,6 +18,7 @@
 #pragma once
 #include "../../Audio/Audio.h"
 #include "../../Constants.h"
+#include "../../Data/MobData.h"
 #include "../../Graphics/EffectLayer.h"
 #include "../../Graphics/Geometry.h"
 #include "../../Graphics/Text.h"
@@ -73,6 +74,8 @@ public:
 
     //! Draw the mob.
     void draw(double viewx, double viewy, float alpha) const override;
+    //! Apply the forces of the current stance.
+    PhysicsObject* prepare_physics() override;
     //! Update movement and animations.
     std::int8_t update(const Physics& physics) override;
 
@@ -111,6 +114,8 @@ public:
 
     //! Check if this mob collides with the specified rectangle.
     bool is_in_range(const Rectangle<std::int16_t>& range) const;
+    //! Returns the area covered by the current animation.
+    Rectangle<std::int16_t> get_bounds() const override;
     //! Check if this mob is still alive.
     bool is_alive() const;
     //! Return the head position.
@@ -151,26 +156,11 @@ private:
     Point<std::int16_t> get_head_position(Point<std::int16_t> position) const;
 
     std::unordered_map<Stance, Animation> animations;
-    std::string name;
+    const MobData& data;
+    const MobData::Stats& stats;
+
     Sound hit_sound;
     Sound die_sound;
-    std::uint16_t level;
-    float speed;
-    float fly_speed;
-    std::uint16_t watk;
-    std::uint16_t matk;
-    std::uint16_t wdef;
-    std::uint16_t mdef;
-    std::uint16_t accuracy;
-    std::uint16_t avoid;
-    std::uint16_t knockback;
-    bool undead;
-    bool touch_damage;
-    bool no_flip;
-    bool not_attack;
-    bool can_move;
-    bool can_jump;
-    bool can_fly;
 
     EffectLayer effects;
     Text name_label;
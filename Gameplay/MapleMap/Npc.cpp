@@ -100,14 +100,17 @@ void Npc::draw(double viewx, double viewy, float alpha) const
     }
 }
 
-std::int8_t Npc::update(const Physics& physics)
+PhysicsObject* Npc::prepare_physics()
+{
+    return active ? &ph_obj : nullptr;
+}
+
+std::int8_t Npc::update(const Physics&)
 {
     if (!active) {
         return ph_obj.fh_layer;
     }
 
-    physics.move_object(ph_obj);
-
     if (animations.count(stance)) {
         bool ani_end = animations.at(stance).update();
         if (ani_end && states.size() > 0) {
@@ -146,15 +149,22 @@ bool Npc::in_range(Point<std::int16_t> cursor_pos,
         return false;
     }
 
-    Point<std::int16_t> absp = get_position() + view_pos;
+    Rectangle<std::int16_t> bounds = get_bounds();
+    bounds.shift(view_pos);
+
+    return bounds.contains(cursor_pos);
+}
+
+Rectangle<std::int16_t> Npc::get_bounds() const
+{
+    Point<std::int16_t> position = get_position();
     Point<std::int16_t> dim = animations.count(stance)
                                   ? animations.at(stance).get_dimensions()
                                   : Point<std::int16_t>{};
 
-    return Rectangle<std::int16_t>{absp.x() - dim.x() / 2,
-                                   absp.x() + dim.x() / 2,
-                                   absp.y() - dim.y(),
-                                   absp.y()}
-        .contains(cursor_pos);
+    return {position.x() - dim.x() / 2,
+            position.x() + dim.x() / 2,
+            position.y() - dim.y(),
+            position.y()};
 }
 } // namespace jrc
@@ -44,6 +44,7 @@ public:
     //! Draws the current animation and name/function tags.
     void draw(double viewx, double viewy, float alpha) const override;
     //! Updates the current animation and physics.
+    PhysicsObject* prepare_physics() override;
     std::int8_t update(const Physics& physics) override;
 
     //! Changes stance and resets animation.
@@ -54,6 +55,8 @@ public:
     //! Check if the NPC is in range of the cursor.
     bool in_range(Point<std::int16_t> cursor_pos,
                   Point<std::int16_t> view_pos) const noexcept;
+    //! Returns the area covered by the current animation.
+    Rectangle<std::int16_t> get_bounds() const override;
 
 private:
     std::unordered_map<std::string, Animation> animations;
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "SpatialGrid.h"
+
+#include <cstdlib>
+
+namespace jrc
+{
+void SpatialGrid::update(MapObject* object)
+{
+    Point<std::int16_t> position = object->get_position();
+    Rectangle<std::int16_t> bounds = object->get_bounds();
+
+    std::int32_t extent = std::max({std::abs(bounds.l() - position.x()),
+                                    std::abs(bounds.r() - position.x()),
+                                    std::abs(bounds.t() - position.y()),
+                                    std::abs(bounds.b() - position.y())});
+    reach = std::max(reach, extent);
+
+    std::int64_t key = key_of(cell_of(position.x()), cell_of(position.y()));
+
+    auto [iter, inserted] = keys.try_emplace(object, key);
+    if (!inserted) {
+        if (iter->second == key) {
+            return;
+        }
+
+        remove(object);
+        keys.emplace(object, key);
+    }
+
+    cells[key].push_back(object);
+}
+
+void SpatialGrid::remove(const MapObject* object)
+{
+    auto iter = keys.find(object);
+    if (iter == keys.end()) {
+        return;
+    }
+
+    auto cell = cells.find(iter->second);
+    if (cell != cells.end()) {
+        std::vector<MapObject*>& objects = cell->second;
+        auto found = std::find(objects.begin(), objects.end(), object);
+        if (found != objects.end()) {
+            *found = objects.back();
+            objects.pop_back();
+        }
+    }
+
+    keys.erase(iter);
+}
+
+void SpatialGrid::clear()
+{
+    cells.clear();
+    keys.clear();
+    reach = 0;
+}
+
+std::int32_t SpatialGrid::cell_of(std::int32_t coordinate) noexcept
+{
+    // Round towards negative infinity, so that cells have equal size on
+    // both sides of the origin.
+    std::int32_t cell = coordinate / CELL_SIZE;
+    return coordinate % CELL_SIZE < 0 ? cell - 1 : cell;
+}
+
+std::int64_t SpatialGrid::key_of(std::int32_t x, std::int32_t y) noexcept
+{
+    return (static_cast<std::int64_t>(x) << 32)
+           | static_cast<std::uint32_t>(y);
+}
+} // namespace jrc
@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../Template/Rectangle.h"
+#include "MapObject.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace jrc
+{
+//! Uniform grid which buckets map objects by their position, so that area
+//! queries only visit objects in nearby cells.
+class SpatialGrid
+{
+public:
+    //! Add an object, or move it to the cell of its current position.
+    void update(MapObject* object);
+    //! Remove an object.
+    void remove(const MapObject* object);
+    //! Remove all objects.
+    void clear();
+
+    template<typename F>
+    //! Call `action` for every object whose bounds may overlap `area`, until
+    //! it returns true. Returns whether `action` returned true.
+    bool query(const Rectangle<std::int16_t>& area, F&& action) const
+    {
+        // Objects are bucketed by position, so widen the area by the
+        // furthest any object reaches from its position.
+        std::int32_t left = cell_of(std::min(area.l(), area.r()) - reach);
+        std::int32_t right = cell_of(std::max(area.l(), area.r()) + reach);
+        std::int32_t top = cell_of(std::min(area.t(), area.b()) - reach);
+        std::int32_t bottom = cell_of(std::max(area.t(), area.b()) + reach);
+
+        for (std::int32_t y = top; y <= bottom; ++y) {
+            for (std::int32_t x = left; x <= right; ++x) {
+                auto iter = cells.find(key_of(x, y));
+                if (iter == cells.end()) {
+                    continue;
+                }
+
+                for (MapObject* object : iter->second) {
+                    if (action(*object)) {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+private:
+    static constexpr const std::int32_t CELL_SIZE = 256;
+
+    static std::int32_t cell_of(std::int32_t coordinate) noexcept;
+    static std::int64_t key_of(std::int32_t x, std::int32_t y) noexcept;
+
+    std::unordered_map<std::int64_t, std::vector<MapObject*>> cells;
+    std::unordered_map<const MapObject*, std::int64_t> keys;
+    std::int32_t reach = 0;
+};
+} // namespace jrc
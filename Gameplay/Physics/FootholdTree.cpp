@@ -19,6 +19,8 @@
 
 #include "../../Console.h"
 
+#include <algorithm>
+
 namespace jrc
 {
 Footholdtree::Footholdtree(WzNode src)
@@ -50,12 +52,16 @@ Footholdtree::Footholdtree(WzNode src)
                     continue;
                 }
 
-                const Foothold& foothold
-                    = footholds
-                          .emplace(std::piecewise_construct,
-                                   std::forward_as_tuple(id),
-                                   std::forward_as_tuple(lastf, id, layer))
-                          .first->second;
+                if (id >= footholds.size()) {
+                    footholds.resize(id + 1);
+                }
+
+                // The first foothold with an id wins, same as with a map.
+                if (!footholds[id].id()) {
+                    footholds[id] = Foothold(lastf, id, layer);
+                }
+
+                const Foothold& foothold = footholds[id];
 
                 if (foothold.l() < leftw) {
                     leftw = foothold.l();
@@ -72,22 +78,54 @@ Footholdtree::Footholdtree(WzNode src)
                 if (foothold.t() < topb) {
                     topb = foothold.t();
                 }
-
-                if (foothold.is_wall()) {
-                    continue;
-                }
-
-                std::int16_t start = foothold.l();
-                std::int16_t end = foothold.r();
-                for (std::int16_t i = start; i <= end; ++i) {
-                    footholdsbyx.emplace(i, id);
-                }
             }
         }
     }
 
     walls = {leftw + 25, rightw - 25};
     borders = {topb - 300, botb + 100};
+
+    slab_origin = leftw;
+    index_footholds();
+}
+
+void Footholdtree::index_footholds()
+{
+    auto slab_of = [this](std::int32_t x) {
+        return static_cast<std::size_t>((x - slab_origin) / SLAB_WIDTH);
+    };
+
+    std::size_t slab_count = 0;
+    for (const Foothold& fh : footholds) {
+        if (fh.id() && !fh.is_wall()) {
+            slab_count = std::max(slab_count, slab_of(fh.r()) + 1);
+        }
+    }
+
+    // Count the footholds per slab, then place them with a prefix sum.
+    slab_offsets.assign(slab_count + 1, 0);
+    for (const Foothold& fh : footholds) {
+        if (fh.id() && !fh.is_wall()) {
+            for (std::size_t i = slab_of(fh.l()); i <= slab_of(fh.r()); ++i) {
+                ++slab_offsets[i + 1];
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < slab_count; ++i) {
+        slab_offsets[i + 1] += slab_offsets[i];
+    }
+
+    std::vector<std::uint32_t> fill(slab_offsets.begin(),
+                                    slab_offsets.end() - 1);
+    slab_footholds.resize(slab_offsets.back());
+    for (const Foothold& fh : footholds) {
+        if (fh.id() && !fh.is_wall()) {
+            for (std::size_t i = slab_of(fh.l()); i <= slab_of(fh.r()); ++i) {
+                slab_footholds[fill[i]++] = fh.id();
+            }
+        }
+    }
 }
 
 Footholdtree::Footholdtree() = default;
@@ -213,12 +251,11 @@ void Footholdtree::update_fh(PhysicsObject& phobj) const
 
 const Foothold& Footholdtree::get_fh(std::uint16_t fhid) const
 {
-    auto iter = footholds.find(fhid);
-    if (iter == footholds.end()) {
+    if (fhid >= footholds.size()) {
         return nullfh;
     }
 
-    return iter->second;
+    return footholds[fhid];
 }
 
 double Footholdtree::get_wall(std::uint16_t curid, bool left, double fy) const
@@ -289,9 +326,22 @@ std::uint16_t Footholdtree::get_fhid_below(double fx, double fy) const
     double comp = borders.second();
 
     auto x = static_cast<std::int16_t>(fx);
-    auto range = footholdsbyx.equal_range(x);
-    for (auto iter = range.first; iter != range.second; ++iter) {
-        const Foothold& fh = footholds.at(iter->second);
+    if (x < slab_origin) {
+        return ret;
+    }
+
+    auto slab = static_cast<std::size_t>((x - slab_origin) / SLAB_WIDTH);
+    if (slab + 1 >= slab_offsets.size()) {
+        return ret;
+    }
+
+    for (std::uint32_t i = slab_offsets[slab]; i < slab_offsets[slab + 1];
+         ++i) {
+        const Foothold& fh = footholds[slab_footholds[i]];
+        if (x < fh.l() || x > fh.r()) {
+            continue;
+        }
+
         double ycomp = fh.ground_below(fx);
         if (comp >= ycomp && ycomp >= fy) {
             comp = ycomp;
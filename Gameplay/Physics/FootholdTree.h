@@ -19,7 +19,8 @@
 #include "Foothold.h"
 #include "PhysicsObject.h"
 
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 namespace jrc
 {
@@ -50,8 +51,19 @@ private:
     double get_edge(std::uint16_t fhid, bool left) const;
     const Foothold& get_fh(std::uint16_t fhid) const;
 
-    std::unordered_map<std::uint16_t, Foothold> footholds;
-    std::unordered_multimap<std::int16_t, std::uint16_t> footholdsbyx;
+    // Build the slab index over all footholds which are not walls.
+    void index_footholds();
+
+    // Width of the vertical slabs which footholds are bucketed into.
+    static constexpr const std::int32_t SLAB_WIDTH = 64;
+
+    // Footholds indexed by id. Unused ids hold an empty foothold.
+    std::vector<Foothold> footholds;
+    // Ids of the footholds overlapping each slab, stored contiguously.
+    // The ids for slab i are in [slab_offsets[i], slab_offsets[i + 1]).
+    std::vector<std::uint16_t> slab_footholds;
+    std::vector<std::uint32_t> slab_offsets;
+    std::int32_t slab_origin = 0;
 
     Foothold nullfh;
     Range<std::int16_t> walls;
@@ -18,6 +18,7 @@
 #include "Physics.h"
 
 #include <functional>
+#include <vector>
 
 namespace jrc
 {
@@ -29,6 +30,137 @@ const double GROUNDSLIP = 3.0;
 const double FLYFRICTION = 0.05;
 const double SWIMFRICTION = 0.08;
 
+namespace
+{
+// Movement properties of a group of objects using the same physics engine,
+// stored as one array per property.
+struct PhysicsBatch {
+    std::vector<PhysicsObject*> objects;
+    std::vector<double> hspeed;
+    std::vector<double> vspeed;
+    std::vector<double> h_force;
+    std::vector<double> v_force;
+    std::vector<double> h_acc;
+    std::vector<double> v_acc;
+    std::vector<double> fh_slope;
+    std::vector<std::uint8_t> on_ground;
+    std::vector<std::uint8_t> no_gravity;
+
+    void gather()
+    {
+        std::size_t count = objects.size();
+        hspeed.resize(count);
+        vspeed.resize(count);
+        h_force.resize(count);
+        v_force.resize(count);
+        h_acc.resize(count);
+        v_acc.resize(count);
+        fh_slope.resize(count);
+        on_ground.resize(count);
+        no_gravity.resize(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const PhysicsObject& phobj = *objects[i];
+            hspeed[i] = phobj.hspeed;
+            vspeed[i] = phobj.vspeed;
+            h_force[i] = phobj.h_force;
+            v_force[i] = phobj.v_force;
+            fh_slope[i] = phobj.fh_slope;
+            on_ground[i] = phobj.on_ground;
+            no_gravity[i] = (phobj.flags & PhysicsObject::NO_GRAVITY) != 0;
+        }
+    }
+
+    void scatter() const
+    {
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            PhysicsObject& phobj = *objects[i];
+            phobj.hspeed = hspeed[i];
+            phobj.vspeed = vspeed[i];
+            phobj.h_force = 0.0;
+            phobj.v_force = 0.0;
+            phobj.h_acc = h_acc[i];
+            phobj.v_acc = v_acc[i];
+        }
+    }
+
+    void clear()
+    {
+        objects.clear();
+    }
+};
+
+// The loops below mirror Physics::move_normal, move_flying and
+// move_swimming. Branches are written as selects, so that they can be
+// vectorised.
+
+void move_normal(PhysicsBatch& b)
+{
+    std::size_t count = b.objects.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        bool ground = b.on_ground[i] != 0;
+        double hspeed = b.hspeed[i];
+        double h_acc = ground ? b.h_force[i] : 0.0;
+        double v_acc = ground ? b.v_force[i]
+                              : (b.no_gravity[i] ? 0.0 : GRAVFORCE);
+
+        bool stop = ground && h_acc == 0.0 && hspeed < 0.1 && hspeed > -0.1;
+        double inertia = hspeed / GROUNDSLIP;
+        double slopef = std::clamp(b.fh_slope[i], -0.5, 0.5);
+        double friction
+            = (FRICTION + SLOPEFACTOR * (1.0 + slopef * -inertia)) * inertia;
+
+        h_acc = (ground && !stop) ? h_acc - friction : h_acc;
+        hspeed = stop ? 0.0 : hspeed;
+
+        b.h_acc[i] = h_acc;
+        b.v_acc[i] = v_acc;
+        b.hspeed[i] = hspeed + h_acc;
+        b.vspeed[i] += v_acc;
+    }
+}
+
+void move_flying(PhysicsBatch& b)
+{
+    std::size_t count = b.objects.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        double h_acc = b.h_force[i] - FLYFRICTION * b.hspeed[i];
+        double v_acc = b.v_force[i] - FLYFRICTION * b.vspeed[i];
+        double hspeed = b.hspeed[i] + h_acc;
+        double vspeed = b.vspeed[i] + v_acc;
+
+        bool hstop = h_acc == 0.0 && hspeed < 0.1 && hspeed > -0.1;
+        bool vstop = v_acc == 0.0 && vspeed < 0.1 && vspeed > -0.1;
+
+        b.h_acc[i] = h_acc;
+        b.v_acc[i] = v_acc;
+        b.hspeed[i] = hstop ? 0.0 : hspeed;
+        b.vspeed[i] = vstop ? 0.0 : vspeed;
+    }
+}
+
+void move_swimming(PhysicsBatch& b)
+{
+    std::size_t count = b.objects.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        double h_acc = b.h_force[i] - SWIMFRICTION * b.hspeed[i];
+        double v_acc = b.v_force[i] - SWIMFRICTION * b.vspeed[i];
+        v_acc = b.no_gravity[i] ? v_acc : v_acc + SWIMGRAVFORCE;
+
+        double hspeed = b.hspeed[i] + h_acc;
+        double vspeed = b.vspeed[i] + v_acc;
+
+        bool hstop = h_acc == 0.0 && hspeed < 0.1 && hspeed > -0.1;
+        bool vstop = v_acc == 0.0 && vspeed < 0.1 && vspeed > -0.1;
+
+        b.h_acc[i] = h_acc;
+        b.v_acc[i] = v_acc;
+        b.hspeed[i] = hstop ? 0.0 : hspeed;
+        b.vspeed[i] = vstop ? 0.0 : vspeed;
+    }
+}
+} // namespace
+
 Physics::Physics(WzNode src)
 {
     fht = src;
@@ -66,6 +198,64 @@ void Physics::move_object(PhysicsObject& phobj) const
     phobj.move();
 }
 
+void Physics::move_objects(PhysicsObject* const* objects,
+                           std::size_t count) const
+{
+    // Scratch buffers are kept to avoid allocating every frame.
+    static PhysicsBatch normal;
+    static PhysicsBatch flying;
+    static PhysicsBatch swimming;
+
+    normal.clear();
+    flying.clear();
+    swimming.clear();
+
+    // Determine which platform the objects are currently on, and group them
+    // by the physics engine to use.
+    for (std::size_t i = 0; i < count; ++i) {
+        PhysicsObject& phobj = *objects[i];
+        fht.update_fh(phobj);
+
+        switch (phobj.type) {
+        case PhysicsObject::NORMAL:
+            normal.objects.push_back(&phobj);
+            break;
+        case PhysicsObject::FLYING:
+            flying.objects.push_back(&phobj);
+            break;
+        case PhysicsObject::SWIMMING:
+            swimming.objects.push_back(&phobj);
+            break;
+        default:
+            break;
+        }
+    }
+
+    normal.gather();
+    jrc::move_normal(normal);
+    normal.scatter();
+
+    flying.gather();
+    jrc::move_flying(flying);
+    flying.scatter();
+
+    swimming.gather();
+    jrc::move_swimming(swimming);
+    swimming.scatter();
+
+    // Collision checks depend on the foothold tree, and are done per object.
+    for (const PhysicsBatch* batch : {&normal, &flying, &swimming}) {
+        for (PhysicsObject* phobj : batch->objects) {
+            fht.limit_movement(*phobj);
+        }
+    }
+
+    // Move the objects forward.
+    for (std::size_t i = 0; i < count; ++i) {
+        objects[i]->move();
+    }
+}
+
 void Physics::move_normal(PhysicsObject& phobj) const
 {
     phobj.v_acc = 0.0;
@@ -30,6 +30,10 @@ public:
 
     // Move the specified object over the specified game-time.
     void move_object(PhysicsObject& tomove) const;
+    // Move several objects over the specified game-time. Has the same result
+    // as calling move_object on each, but runs the force calculations in
+    // tight loops over contiguous arrays.
+    void move_objects(PhysicsObject* const* objects, std::size_t count) const;
     // Determine the point on the ground below the specified position.
     Point<std::int16_t> get_y_below(Point<std::int16_t> position) const;
     // Return a reference to the collection of platforms.
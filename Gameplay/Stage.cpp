@@ -19,10 +19,13 @@
 
 #include "../Audio/Audio.h"
 #include "../Character/SkillId.h"
+#include "../Graphics/GraphicsGL.h"
 #include "../IO/Messages.h"
+#include "../IO/UI.h"
 #include "../Net/Packets/AttackAndSkillPackets.h"
 #include "../Net/Packets/GameplayPackets.h"
 #include "../Util/Misc.h"
+#include "../Util/Profiler.h"
 #include "Wz.h"
 
 #include <iostream>
@@ -39,6 +42,23 @@ void Stage::init()
     drops.init();
 }
 
+void Stage::prepare()
+{
+    // Queue the player's skills to be built. Definitions which are
+    // already cached are skipped quickly.
+    std::vector<std::int32_t> skill_ids;
+    for (const auto& [skill_id, _] : player.get_skills().get_entries()) {
+        skill_ids.push_back(skill_id);
+    }
+    for (const auto& [_, mapping] : UI::get().get_keyboard().get_maplekeys()) {
+        if (mapping.type == KeyType::SKILL) {
+            skill_ids.push_back(mapping.action);
+        }
+    }
+
+    combat.prewarm(skill_ids);
+}
+
 void Stage::load(std::int32_t map_id, std::int8_t portal_id)
 {
     switch (state) {
@@ -71,23 +91,19 @@ void Stage::clear()
     mobs.clear();
     drops.clear();
     reactors.clear();
+
+    Sound::free_unused();
 }
 
 void Stage::load_map(std::int32_t map_id)
 {
-    std::string str_id = string_format::extend_id(map_id, 9);
-    str_id += ".img";
+    MapLoader::MapData data = MapLoader::load(map_id);
 
-    WzNode src
-        = WzFile::map["Map"]["Map" + std::to_string(map_id / 100'000'000)]
-                     [str_id];
-
-    tiles_objs = MapTilesObjs(src);
-    backgrounds = MapBackgrounds(src["back"]);
-    physics = Physics(src["foothold"]);
-    map_info = {
-        src, physics.get_fht().get_walls(), physics.get_fht().get_borders()};
-    portals = MapPortals(src["portal"], map_id);
+    tiles_objs = std::move(data.tiles_objs);
+    backgrounds = std::move(data.backgrounds);
+    physics = std::move(data.physics);
+    map_info = std::move(data.map_info);
+    portals = std::move(data.portals);
 }
 
 void Stage::respawn(std::int8_t portal_id)
@@ -112,6 +128,9 @@ void Stage::draw(float alpha) const
         return;
     }
 
+    ProfileScope scope{"Stage::draw"};
+    GraphicsGL::get().set_layer(GraphicsGL::STAGE);
+
     Point<std::int16_t> viewpos = camera.position(alpha);
     Point<double> viewrpos = camera.realposition(alpha);
     double viewx = viewrpos.x();
@@ -138,15 +157,32 @@ void Stage::update()
         return;
     }
 
+    ProfileScope scope{"Stage::update"};
+
     combat.update();
     backgrounds.update();
     tiles_objs.update();
 
-    reactors.update(physics);
-    npcs.update(physics);
-    mobs.update(physics);
-    chars.update(physics);
-    drops.update(physics);
+    {
+        ProfileScope reactors_scope{"MapReactors::update"};
+        reactors.update(physics);
+    }
+    {
+        ProfileScope npcs_scope{"MapNpcs::update"};
+        npcs.update(physics);
+    }
+    {
+        ProfileScope mobs_scope{"MapMobs::update"};
+        mobs.update(physics);
+    }
+    {
+        ProfileScope chars_scope{"MapChars::update"};
+        chars.update(physics);
+    }
+    {
+        ProfileScope drops_scope{"MapDrops::update"};
+        drops.update(physics);
+    }
     player.update(physics);
 
     portals.update(player.get_position());
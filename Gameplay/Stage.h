@@ -22,6 +22,7 @@
 #include "../Template/TimedQueue.h"
 #include "Camera.h"
 #include "Combat/Combat.h"
+#include "MapLoader.h"
 #include "MapleMap/MapBackgrounds.h"
 #include "MapleMap/MapChars.h"
 #include "MapleMap/MapDrops.h"
@@ -43,6 +44,8 @@ public:
 
     void init();
 
+    //! Queue the player's skills to be built ahead of their first use.
+    void prepare();
     //! Loads the map to be displayed.
     void load(std::int32_t map_id, std::int8_t portal_id);
     //! Removes all map objects and graphics.
@@ -132,8 +132,11 @@ float Frame::scale_step(std::uint16_t timestep) const
     return timestep * static_cast<float>(scales.second - scales.first) / delay;
 }
 
-Animation::Animation(WzNode src) : finished(false)
+Animation::Animation(WzNode src)
 {
+    auto loaded = std::make_shared<AnimationData>();
+    std::vector<Frame>& frames = loaded->frames;
+
     bool is_texture = src.getNodeType() == WzNode::NodeType::BITMAP;
     if (is_texture) {
         frames.emplace_back(src);
@@ -152,6 +155,7 @@ Animation::Animation(WzNode src) : finished(false)
         }
         std::sort(frame_ids.begin(), frame_ids.end());
 
+        frames.reserve(frame_ids.size());
         for (auto fid : frame_ids) {
             frames.emplace_back(src[fid]);
         }
@@ -161,43 +165,52 @@ Animation::Animation(WzNode src) : finished(false)
         }
     }
 
-    animated = frames.size() > 1;
-    zigzag = src["zigzag"].getBoolean();
-    repeat = src["repeat"];
+    loaded->zigzag = src["zigzag"].getBoolean();
+    loaded->repeat = src["repeat"];
+    data = std::move(loaded);
 
     reset();
 }
 
 Animation::Animation() noexcept
-    : animated(false), zigzag(false), finished(true)
 {
-    frames.emplace_back();
-
+    // All empty animations share the same single blank frame.
+    static const auto empty = [] {
+        auto blank = std::make_shared<AnimationData>();
+        blank->frames.emplace_back();
+        return blank;
+    }();
+
+    data = empty;
     reset();
+    cursor.finished = true;
 }
 
 void Animation::reset()
 {
-    frame.set(0);
-    opacity.set(frames[0].start_opacity());
-    xy_scale.set(frames[0].start_scale());
-    delay = frames[0].get_delay();
-    frame_step = 1;
+    const Frame& first = data->frames[0];
+
+    cursor.frame.set(0);
+    cursor.opacity.set(first.start_opacity());
+    cursor.xy_scale.set(first.start_scale());
+    cursor.delay = first.get_delay();
+    cursor.frame_step = 1;
 }
 
 void Animation::draw(const DrawArgument& args, float alpha) const
 {
-    std::int16_t interframe = frame.get(alpha);
-    float inter_opc = opacity.get(alpha) / 255.0f;
-    float inter_scale = xy_scale.get(alpha) / 100.0f;
+    std::int16_t interframe = cursor.frame.get(alpha);
+    float inter_opc = cursor.opacity.get(alpha) / 255.0f;
+    float inter_scale = cursor.xy_scale.get(alpha) / 100.0f;
 
+    const Frame& frame_data = data->frames[interframe];
     bool modify_opc = inter_opc != 1.0f;
     bool modify_scale = inter_scale != 1.0f;
     if (modify_opc || modify_scale) {
-        frames[interframe].draw(
+        frame_data.draw(
             args + DrawArgument{inter_scale, inter_scale, inter_opc});
     } else {
-        frames[interframe].draw(args);
+        frame_data.draw(args);
     }
 }
 
@@ -208,40 +221,42 @@ bool Animation::update()
 
 bool Animation::update(std::uint16_t timestep)
 {
-    if (finished) {
+    if (cursor.finished) {
         return true;
     }
 
+    const std::vector<Frame>& frames = data->frames;
     const Frame& frame_data = get_frame();
 
-    opacity += frame_data.opc_step(timestep);
-    if (opacity.last() < 0.0f) {
-        opacity.set(0.0f);
-    } else if (opacity.last() > 255.0f) {
-        opacity.set(255.0f);
+    cursor.opacity += frame_data.opc_step(timestep);
+    if (cursor.opacity.last() < 0.0f) {
+        cursor.opacity.set(0.0f);
+    } else if (cursor.opacity.last() > 255.0f) {
+        cursor.opacity.set(255.0f);
     }
 
-    xy_scale += frame_data.scale_step(timestep);
-    if (xy_scale.last() < 0.0f) {
-        opacity.set(0.0f);
+    cursor.xy_scale += frame_data.scale_step(timestep);
+    if (cursor.xy_scale.last() < 0.0f) {
+        cursor.opacity.set(0.0f);
     }
 
-    if (timestep >= delay) {
+    if (timestep >= cursor.delay) {
         auto last_frame = static_cast<std::int16_t>(frames.size() - 1);
+        std::int16_t frame = cursor.frame.get();
         std::int16_t next_frame;
         bool ended;
-        if (zigzag && last_frame > 0) {
-            if (frame_step == 1 && frame == last_frame) {
-                frame_step = -frame_step;
+        if (data->zigzag && last_frame > 0) {
+            if (cursor.frame_step == 1 && frame == last_frame) {
+                cursor.frame_step = -cursor.frame_step;
                 ended = false;
-            } else if (frame_step == -1 && frame == 0) {
-                frame_step = -frame_step;
+            } else if (cursor.frame_step == -1 && frame == 0) {
+                cursor.frame_step = -cursor.frame_step;
                 ended = true;
             } else {
                 ended = false;
             }
 
-            next_frame = frame + frame_step;
+            next_frame = frame + cursor.frame_step;
         } else {
             if (frame == last_frame) {
                 next_frame = 0;
@@ -252,36 +267,38 @@ bool Animation::update(std::uint16_t timestep)
             }
         }
 
-        if (ended && repeat == -1) {
-            finished = true;
+        if (ended && data->repeat == -1) {
+            cursor.finished = true;
 
-            opacity.set(frames[last_frame].end_opacity());
-            xy_scale.set(frames[last_frame].end_scale());
+            cursor.opacity.set(frames[last_frame].end_opacity());
+            cursor.xy_scale.set(frames[last_frame].end_scale());
         } else {
-            std::uint16_t delta = timestep - delay;
+            std::uint16_t delta = timestep - cursor.delay;
             float threshold = static_cast<float>(delta) / timestep;
-            frame.next(next_frame, threshold);
+            cursor.frame.next(next_frame, threshold);
 
-            delay = frames[next_frame].get_delay();
-            if (delay >= delta) {
-                delay -= delta;
+            cursor.delay = frames[next_frame].get_delay();
+            if (cursor.delay >= delta) {
+                cursor.delay -= delta;
             }
 
-            opacity.set(frames[next_frame].start_opacity());
-            xy_scale.set(frames[next_frame].start_scale());
+            cursor.opacity.set(frames[next_frame].start_opacity());
+            cursor.xy_scale.set(frames[next_frame].start_scale());
         }
 
         return ended;
     }
 
-    frame.normalize();
-    delay -= timestep;
+    cursor.frame.normalize();
+    cursor.delay -= timestep;
 
     return false;
 }
 
 std::uint16_t Animation::get_delay(std::int16_t frame_id) const
 {
+    const std::vector<Frame>& frames = data->frames;
+
     return frame_id < static_cast<std::int16_t>(frames.size())
                ? frames[frame_id].get_delay()
                : 0u;
@@ -289,6 +306,8 @@ std::uint16_t Animation::get_delay(std::int16_t frame_id) const
 
 std::uint16_t Animation::get_delay_until(std::int16_t frame_id) const
 {
+    const std::vector<Frame>& frames = data->frames;
+
     std::uint16_t total = 0;
     for (std::int16_t i = 0; i < frame_id; ++i) {
         if (i >= static_cast<std::int16_t>(frames.size())) {
@@ -323,6 +342,6 @@ Rectangle<std::int16_t> Animation::get_bounds() const
 
 const Frame& Animation::get_frame() const
 {
-    return frames[frame.get()];
+    return data->frames[cursor.frame.get()];
 }
 } // namespace jrc
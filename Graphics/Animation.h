@@ -21,6 +21,7 @@
 #include "Texture.h"
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 namespace jrc
@@ -55,7 +56,30 @@ private:
     Point<std::int16_t> head;
 };
 
+//! The frames of an animation and how they are played, as loaded from the
+//! game data. Never changes after loading, so it is shared by all copies of
+//! an `Animation`.
+struct AnimationData {
+    std::vector<Frame> frames;
+    bool zigzag = false;
+    std::int16_t repeat = 0;
+};
+
+//! Playback state of an animation.
+struct AnimationCursor {
+    Nominal<std::int16_t> frame;
+    Linear<float> opacity;
+    Linear<float> xy_scale;
+    //! Time left until the next frame.
+    std::uint16_t delay = 0;
+    std::int16_t frame_step = 1;
+    bool finished = false;
+};
+
 //! Class which consists of multiple textures to make an Animation.
+//!
+//! The frames are shared between copies, so copying an animation only
+//! copies its playback state.
 class Animation
 {
 public:
@@ -78,19 +102,7 @@ public:
 private:
     const Frame& get_frame() const;
 
-    std::vector<Frame> frames;
-    bool animated;
-    bool zigzag;
-
-    Nominal<std::int16_t> frame;
-    Linear<float> opacity;
-    Linear<float> xy_scale;
-
-    std::uint16_t delay;
-    std::int16_t frame_step;
-    float opcstep;
-
-    std::int16_t repeat;
-    bool finished;
+    std::shared_ptr<const AnimationData> data;
+    AnimationCursor cursor;
 };
 } // namespace jrc
@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "CompositeCache.h"
+
+namespace jrc
+{
+CompositeCache::CompositeCache() noexcept = default;
+
+CompositeCache::~CompositeCache()
+{
+    clear();
+}
+
+CompositeCache::CompositeCache(const CompositeCache&) noexcept
+    : CompositeCache()
+{
+}
+
+CompositeCache& CompositeCache::operator=(const CompositeCache& other)
+{
+    if (this != &other) {
+        clear();
+    }
+
+    return *this;
+}
+
+CompositeCache::CompositeCache(CompositeCache&& other) noexcept
+    : entries{std::move(other.entries)}
+{
+    other.entries.clear();
+}
+
+CompositeCache& CompositeCache::operator=(CompositeCache&& other) noexcept
+{
+    std::swap(entries, other.entries);
+    return *this;
+}
+
+void CompositeCache::clear()
+{
+    auto& graphics = GraphicsGL::get();
+    for (auto& [_, id] : entries) {
+        graphics.free_composite(id);
+    }
+
+    entries.clear();
+}
+} // namespace jrc
@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "DrawArgument.h"
+#include "GraphicsGL.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace jrc
+{
+//! Images of an object drawn from many bitmaps, eg. the layers of a
+//! character, each rendered once and then drawn as a single quad. The owner
+//! chooses a key for every combination of bitmaps it draws, and calls
+//! `clear()` when the bitmaps behind the keys change.
+//!
+//! Copies start out empty, as the images belong to the original.
+class CompositeCache
+{
+public:
+    CompositeCache() noexcept;
+    ~CompositeCache();
+
+    CompositeCache(const CompositeCache&) noexcept;
+    CompositeCache& operator=(const CompositeCache& other);
+
+    CompositeCache(CompositeCache&& other) noexcept;
+    CompositeCache& operator=(CompositeCache&& other) noexcept;
+
+    //! Draw the image stored under `key`, recording the bitmaps drawn by
+    //! `draw_fn` at the origin first if there is none. Return `false` if
+    //! no image could be drawn, in which case the caller has to draw the
+    //! bitmaps itself.
+    template<typename DrawFn>
+    bool draw(std::uint32_t key, const DrawArgument& args, DrawFn&& draw_fn)
+    {
+        auto& graphics = GraphicsGL::get();
+
+        auto iter = entries.find(key);
+        if (iter != entries.end()
+            && graphics.draw_composite(iter->second, args)) {
+            return true;
+        }
+
+        if (!graphics.begin_composite()) {
+            return false;
+        }
+
+        std::forward<DrawFn>(draw_fn)();
+        GraphicsGL::CompositeId id = graphics.end_composite();
+        if (id == GraphicsGL::NULL_COMPOSITE) {
+            return false;
+        }
+
+        if (iter != entries.end()) {
+            graphics.free_composite(iter->second);
+            iter->second = id;
+        } else {
+            entries.emplace(key, id);
+        }
+
+        return graphics.draw_composite(id, args);
+    }
+
+    //! Release every image.
+    void clear();
+
+private:
+    std::unordered_map<std::uint32_t, GraphicsGL::CompositeId> entries;
+};
+} // namespace jrc
@@ -20,38 +20,19 @@
 #include "../Configuration.h"
 #include "../Console.h"
 #include "../IO/Window.h"
+#include "../Util/Profiler.h"
 #include "tinyutf8.h"
 
 #include <algorithm>
+#include <cstring>
 
 using namespace tiny_utf8;
 
 namespace jrc
 {
-Rectangle<std::int16_t> GraphicsGL::screen;
-
-GraphicsGL::GraphicsGL() noexcept : locked{false}, font_border{0, 0}
-{
-    screen = {0,
-              Constants::VIEW_WIDTH,
-              -Constants::VIEW_Y_OFFSET,
-              -Constants::VIEW_Y_OFFSET + Constants::VIEW_HEIGHT};
-}
-
-Error GraphicsGL::init()
+namespace
 {
-    if (glewInit()) {
-        return Error::GLEW;
-    }
-
-    if (FT_Init_FreeType(&ft_library)) {
-        return Error::FREETYPE;
-    }
-
-    GLint result = GL_FALSE;
-
-    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-    const char* vs_source = R"(#version 120
+const char* const LEGACY_VS = R"(#version 120
 attribute vec4 coord;
 attribute vec4 color;
 
@@ -60,29 +41,23 @@ varying vec4 colormod;
 
 uniform vec2 screensize;
 uniform int yoffset;
+uniform vec2 translation;
 
 void main(void) {
-    float x = -1.0 + coord.x * 2.0 / screensize.x;
-    float y = 1.0 - (coord.y + yoffset) * 2.0 / screensize.y;
+    vec2 pos = coord.xy + translation;
+    float x = -1.0 + pos.x * 2.0 / screensize.x;
+    float y = 1.0 - (pos.y + yoffset) * 2.0 / screensize.y;
 
     gl_Position = vec4(x, y, 0.0, 1.0);
     texpos = coord.zw;
     colormod = color;
 })";
 
-    glShaderSource(vs, 1, &vs_source, NULL);
-    glCompileShader(vs);
-    glGetShaderiv(vs, GL_COMPILE_STATUS, &result);
-    if (!result) {
-        return Error::VERTEX_SHADER;
-    }
-
-    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-    const char* fs_source = R"(#version 120
+const char* const LEGACY_FS = R"(#version 120
 varying vec2 texpos;
 varying vec4 colormod;
 
-uniform sampler2D texture;
+uniform sampler2D atlas;
 uniform vec2 atlassize;
 uniform int fontregion;
 
@@ -94,58 +69,148 @@ void main(void) {
             1,
             1,
             1,
-            texture2D(texture, texpos / atlassize).r
+            texture2D(atlas, texpos / atlassize).r
         ) * colormod;
     } else {
-        gl_FragColor = texture2D(texture, texpos / atlassize) * colormod;
+        gl_FragColor = texture2D(atlas, texpos / atlassize) * colormod;
     }
 })";
 
-    glShaderSource(fs, 1, &fs_source, NULL);
-    glCompileShader(fs);
-    glGetShaderiv(fs, GL_COMPILE_STATUS, &result);
-    if (!result) {
-        return Error::FRAGMENT_SHADER;
+const char* const MODERN_VS = R"(#version 330
+in vec4 coord;
+in vec4 color;
+
+out vec2 texpos;
+out vec4 colormod;
+
+uniform vec2 screensize;
+uniform int yoffset;
+uniform vec2 translation;
+
+void main(void) {
+    vec2 pos = coord.xy + translation;
+    float x = -1.0 + pos.x * 2.0 / screensize.x;
+    float y = 1.0 - (pos.y + float(yoffset)) * 2.0 / screensize.y;
+
+    gl_Position = vec4(x, y, 0.0, 1.0);
+    texpos = coord.zw;
+    colormod = color;
+})";
+
+const char* const MODERN_FS = R"(#version 330
+in vec2 texpos;
+in vec4 colormod;
+
+out vec4 fragcolor;
+
+uniform sampler2D atlas;
+uniform vec2 atlassize;
+uniform int fontregion;
+
+void main(void) {
+    if (texpos.y == 0.0) {
+        fragcolor = colormod;
+    } else if (texpos.y <= float(fontregion)) {
+        fragcolor = vec4(
+            1.0,
+            1.0,
+            1.0,
+            texture(atlas, texpos / atlassize).r
+        ) * colormod;
+    } else {
+        fragcolor = texture(atlas, texpos / atlassize) * colormod;
     }
+})";
+} // namespace
 
-    program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-    glGetProgramiv(program, GL_LINK_STATUS, &result);
-    if (!result) {
-        return Error::SHADER_PROGRAM;
+Rectangle<std::int16_t> GraphicsGL::screen;
+
+GraphicsGL::GraphicsGL() noexcept
+    : locked{false},
+      locked_frame{0},
+      backend{LEGACY},
+      draw_layer{STAGE},
+      draw_blend{ALPHA},
+      bound_blend{ALPHA},
+      depth_columns{0},
+      depth_rows{0},
+      vbo{0},
+      vao{0},
+      ibo{0},
+      index_capacity{0},
+      ring_data{nullptr},
+      ring_capacity{0},
+      ring_offset{0},
+      ring_segment{0},
+      ring_fences{},
+      bound_page{NULL_PAGE},
+      atlas_full{false},
+      frame{0},
+      recording_static{false},
+      next_static{1},
+      composite_fbo{0},
+      composite_vbo{0},
+      recording_composite{false},
+      composites_full{false},
+      next_composite{1},
+      font_border{0, 0}
+{
+    screen = {0,
+              Constants::VIEW_WIDTH,
+              -Constants::VIEW_Y_OFFSET,
+              -Constants::VIEW_Y_OFFSET + Constants::VIEW_HEIGHT};
+
+    reset_depth();
+    composite_page.reset(1);
+}
+
+Error GraphicsGL::init()
+{
+    GLenum glew_error = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // Contexts created through EGL, like the headless benchmark's, have no
+    // GLX display. The GL entry points are still loaded in that case.
+    if (glew_error == GLEW_ERROR_NO_GLX_DISPLAY) {
+        glew_error = GLEW_OK;
+    }
+#endif
+    if (glew_error != GLEW_OK) {
+        return Error::GLEW;
     }
 
-    attribute_coord = glGetAttribLocation(program, "coord");
-    attribute_color = glGetAttribLocation(program, "color");
-    uniform_texture = glGetUniformLocation(program, "texture");
-    uniform_atlas_size = glGetUniformLocation(program, "atlassize");
-    uniform_screen_size = glGetUniformLocation(program, "screensize");
-    uniform_y_offset = glGetUniformLocation(program, "yoffset");
-    uniform_font_region = glGetUniformLocation(program, "fontregion");
-    if (attribute_coord == -1 || attribute_color == -1 || uniform_texture == -1
-        || uniform_atlas_size == -1 || uniform_y_offset == -1
-        || uniform_screen_size == -1) {
-        return Error::SHADER_VARS;
+    if (FT_Init_FreeType(&ft_library)) {
+        return Error::FREETYPE;
+    }
+
+    backend = LEGACY;
+    if (!Configuration::get().video.legacy_renderer && GLEW_VERSION_3_3) {
+        if (!create_program(MODERN_VS, MODERN_FS)) {
+            backend = MODERN;
+        } else {
+            Console::get().print("[Warning] Could not set up the OpenGL 3.3 "
+                                 "renderer, using the legacy renderer.");
+        }
+    }
+
+    if (backend == LEGACY) {
+        if (Error error = create_program(LEGACY_VS, LEGACY_FS)) {
+            return error;
+        }
     }
 
     glGenBuffers(1, &vbo);
+    if (backend == MODERN) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &ibo);
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        resize_ring(RING_QUADS);
+        reserve_indices(RING_QUADS);
+    }
 
-    glGenTextures(1, &atlas);
-    glBindTexture(GL_TEXTURE_2D, atlas);
+    pages.reserve(MAX_PAGES);
+    add_page();
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D,
-                 0,
-                 GL_RGBA,
-                 ATLASW,
-                 ATLASH,
-                 0,
-                 GL_RGBA,
-                 GL_UNSIGNED_BYTE,
-                 nullptr);
 
     font_border.set_y(1);
 
@@ -170,20 +235,53 @@ void main(void) {
 
     font_y_max += font_border.y();
 
-    leftovers = QuadTree<std::size_t, Leftover>{
-        [](const Leftover& first, const Leftover& second) {
-            bool wcomp = first.width() >= second.width();
-            bool hcomp = first.height() >= second.height();
-            if (wcomp && hcomp) {
-                return QuadTree<std::size_t, Leftover>::RIGHT;
-            } else if (wcomp) {
-                return QuadTree<std::size_t, Leftover>::DOWN;
-            } else if (hcomp) {
-                return QuadTree<std::size_t, Leftover>::UP;
-            } else {
-                return QuadTree<std::size_t, Leftover>::LEFT;
-            }
-        }};
+    pages[0].reset(font_y_max);
+
+    return Error::NONE;
+}
+
+Error GraphicsGL::create_program(const char* vs_source, const char* fs_source)
+{
+    GLint result = GL_FALSE;
+
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vs, 1, &vs_source, NULL);
+    glCompileShader(vs);
+    glGetShaderiv(vs, GL_COMPILE_STATUS, &result);
+    if (!result) {
+        return Error::VERTEX_SHADER;
+    }
+
+    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fs, 1, &fs_source, NULL);
+    glCompileShader(fs);
+    glGetShaderiv(fs, GL_COMPILE_STATUS, &result);
+    if (!result) {
+        return Error::FRAGMENT_SHADER;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &result);
+    if (!result) {
+        return Error::SHADER_PROGRAM;
+    }
+
+    attribute_coord = glGetAttribLocation(program, "coord");
+    attribute_color = glGetAttribLocation(program, "color");
+    uniform_texture = glGetUniformLocation(program, "atlas");
+    uniform_atlas_size = glGetUniformLocation(program, "atlassize");
+    uniform_screen_size = glGetUniformLocation(program, "screensize");
+    uniform_y_offset = glGetUniformLocation(program, "yoffset");
+    uniform_font_region = glGetUniformLocation(program, "fontregion");
+    uniform_translation = glGetUniformLocation(program, "translation");
+    if (attribute_coord == -1 || attribute_color == -1 || uniform_texture == -1
+        || uniform_atlas_size == -1 || uniform_y_offset == -1
+        || uniform_screen_size == -1 || uniform_translation == -1) {
+        return Error::SHADER_VARS;
+    }
 
     return Error::NONE;
 }
@@ -298,191 +396,1075 @@ void GraphicsGL::reinit()
     glUniform2f(uniform_screen_size,
                 Window::get().get_width(),
                 Window::get().get_height());
+    glUniform2f(uniform_translation, 0.0f, 0.0f);
+
+    // The vertex array object keeps the attribute state, so it is only set
+    // up once. The legacy backend enables the arrays in each `flush`.
+    if (backend == MODERN) {
+        glBindVertexArray(vao);
+        glEnableVertexAttribArray(attribute_coord);
+        glEnableVertexAttribArray(attribute_color);
+    }
 
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glVertexAttribPointer(
-        attribute_coord, 4, GL_SHORT, GL_FALSE, sizeof(Quad::Vertex), 0);
-    glVertexAttribPointer(attribute_color,
-                          4,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(Quad::Vertex),
-                          (const void*)8);
+    set_vertex_format();
 
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    apply_blend(ALPHA);
 
-    glBindTexture(GL_TEXTURE_2D, atlas);
+    // Texture bindings belong to the context, which may have changed.
+    bound_page = NULL_PAGE;
+    bind_page(0);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
     clear_internal();
 }
 
+GraphicsGL::Backend GraphicsGL::get_backend() const noexcept
+{
+    return backend;
+}
+
+void GraphicsGL::set_vertex_format()
+{
+    glVertexAttribPointer(
+        attribute_coord, 4, GL_SHORT, GL_FALSE, sizeof(Quad::Vertex), 0);
+    glVertexAttribPointer(attribute_color,
+                          4,
+                          GL_UNSIGNED_BYTE,
+                          GL_TRUE,
+                          sizeof(Quad::Vertex),
+                          (const void*)8);
+}
+
 void GraphicsGL::clear_internal()
 {
-    border = {0, font_y_max};
-    y_range = {};
+    for (std::uint8_t page = 0; page < pages.size(); ++page) {
+        evict_page(page);
+    }
 
-    offsets.clear();
-    leftovers.clear();
-    rlid = 1;
-    wasted = 0;
+    reset_composites();
 }
 
 void GraphicsGL::clear()
 {
-    std::size_t used = ATLASW * border.y() + border.x() * y_range.second();
-    auto used_percent
-        = static_cast<float>(used) / static_cast<float>(ATLASW * ATLASH);
-    if (used_percent > 80.0f) {
-        clear_internal();
+    // Pages drawn from during the last frame may still be on screen.
+    std::uint64_t cold = std::min(frame > 0 ? frame - 1 : 0, live_frame());
+    while (atlas_usage() > TRIM_USAGE) {
+        std::uint8_t page = find_cold_page(cold);
+        if (page == NULL_PAGE) {
+            break;
+        }
+
+        evict_page(page);
     }
 }
 
+const GraphicsGL::AtlasStats& GraphicsGL::get_atlas_stats() const noexcept
+{
+    return atlas_stats;
+}
+
 void GraphicsGL::add_bitmap(const WzBitmap& bmp)
 {
-    get_offset(bmp);
+    get_entry(bmp);
 }
 
-const GraphicsGL::Offset& GraphicsGL::get_offset(const WzBitmap& bmp)
+const GraphicsGL::AtlasEntry& GraphicsGL::get_entry(const WzBitmap& bmp)
 {
     std::size_t id = bmp.id();
     auto offiter = offsets.find(id);
+    if (offiter != offsets.end() && offiter->second.resident) {
+        return offiter->second;
+    }
+
+    GLshort w = bmp.getWidth();
+    GLshort h = bmp.getHeight();
+
+    if (w <= 0 || h <= 0 || w > ATLASW || h > ATLASH) {
+        return null_entry;
+    }
+
+    auto bmp_data = bmp.input.data();
+    if (!bmp_data) {
+        return null_entry;
+    }
+
+    GLshort x = 0;
+    GLshort y = 0;
+    std::uint8_t page = NULL_PAGE;
+    for (std::uint8_t i = 0; i < pages.size(); ++i) {
+        if (pages[i].allocate(w, h, x, y)) {
+            page = i;
+            break;
+        }
+    }
+
+    if (page == NULL_PAGE && pages.size() < MAX_PAGES) {
+        // Even an empty page can not hold a bitmap as tall as the page, as
+        // its first row is reserved.
+        page = add_page();
+        if (!pages[page].allocate(w, h, x, y)) {
+            return null_entry;
+        }
+    }
+
+    if (page == NULL_PAGE) {
+        // Every page is full, so make room in the least recently used one.
+        // Pages drawn from by quads still to be flushed must stay, so the
+        // bitmap is left out if no other page can be evicted.
+        page = find_cold_page(live_frame());
+        if (page == NULL_PAGE) {
+            atlas_full = true;
+            return null_entry;
+        }
+
+        evict_page(page);
+        if (!pages[page].allocate(w, h, x, y)) {
+            atlas_full = true;
+            return null_entry;
+        }
+    }
+
+    AtlasPage& atlas_page = pages[page];
+    auto bytes = static_cast<std::size_t>(w) * static_cast<std::size_t>(h)
+                 * 4;
+    atlas_page.bitmaps.push_back(id);
+    atlas_page.resident_bytes += bytes;
+    atlas_page.last_used = frame;
+    atlas_stats.resident_bytes += bytes;
+
+    bind_page(page);
+    glTexSubImage2D(
+        GL_TEXTURE_2D, 0, x, y, w, h, GL_BGRA, GL_UNSIGNED_BYTE, bmp_data);
+
     if (offiter != offsets.end()) {
+        ++atlas_stats.reuploads;
+        offiter->second = {Offset{x, y, w, h}, page, true};
         return offiter->second;
     }
 
-    GLshort x = 0;
-    GLshort y = 0;
-    
-    GLshort w = bmp.getWidth();
-    GLshort h = bmp.getHeight();
+    ++atlas_stats.uploads;
+    return offsets.emplace(id, AtlasEntry{Offset{x, y, w, h}, page, true})
+        .first->second;
+}
+
+std::uint8_t GraphicsGL::add_page()
+{
+    auto page = static_cast<std::uint8_t>(pages.size());
+    AtlasPage& atlas_page = pages.emplace_back();
+
+    glGenTextures(1, &atlas_page.texture);
+    glBindTexture(GL_TEXTURE_2D, atlas_page.texture);
+    bound_page = page;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_RGBA,
+                 ATLASW,
+                 ATLASH,
+                 0,
+                 GL_RGBA,
+                 GL_UNSIGNED_BYTE,
+                 nullptr);
+
+    // Texture coordinates with a `t` of 0 mark untextured quads, so never
+    // place a bitmap in the first row.
+    atlas_page.reset(1);
+    atlas_page.last_used = frame;
+    atlas_stats.pages = pages.size();
+
+    return page;
+}
+
+void GraphicsGL::bind_page(std::uint8_t page)
+{
+    if (bound_page != page) {
+        glBindTexture(GL_TEXTURE_2D,
+                      page == COMPOSITE_PAGE ? composite_page.texture
+                                             : pages[page].texture);
+        bound_page = page;
+    }
+}
+
+void GraphicsGL::use_page(std::uint8_t page)
+{
+    pages[page].last_used = frame;
+}
+
+void GraphicsGL::add_quad(const Quad& quad, std::uint8_t page)
+{
+    // Rotated quads may extend past their rectangle.
+    GLshort l = quad.vertices[0].x;
+    GLshort r = l;
+    GLshort t = quad.vertices[0].y;
+    GLshort b = t;
+    for (const Quad::Vertex& vertex : quad.vertices) {
+        l = std::min(l, vertex.x);
+        r = std::max(r, vertex.x);
+        t = std::min(t, vertex.y);
+        b = std::max(b, vertex.y);
+    }
+
+    std::uint64_t key = static_cast<std::uint64_t>(draw_layer) << 56
+                        | static_cast<std::uint64_t>(claim_depth(l, r, t, b))
+                              << 24
+                        | static_cast<std::uint64_t>(draw_blend) << 16
+                        | static_cast<std::uint64_t>(page) << 8;
+
+    commands.push_back({key, static_cast<std::uint32_t>(quads.size())});
+    quads.push_back(quad);
+}
+
+std::uint32_t
+GraphicsGL::claim_depth(GLshort l, GLshort r, GLshort t, GLshort b)
+{
+    auto cell = [](GLshort pos, GLshort origin, GLshort count) {
+        return std::clamp(static_cast<GLshort>((pos - origin) / DEPTH_CELL),
+                          static_cast<GLshort>(0),
+                          static_cast<GLshort>(count - 1));
+    };
+
+    GLshort cl = cell(l, screen.l(), depth_columns);
+    GLshort cr = cell(r, screen.l(), depth_columns);
+    GLshort ct = cell(t, screen.t(), depth_rows);
+    GLshort cb = cell(b, screen.t(), depth_rows);
+
+    std::vector<std::uint32_t>& cells = depth_cells[draw_layer];
+    std::uint32_t depth = 0;
+    for (GLshort y = ct; y <= cb; ++y) {
+        for (GLshort x = cl; x <= cr; ++x) {
+            depth = std::max(depth, cells[y * depth_columns + x]);
+        }
+    }
+
+    ++depth;
+    for (GLshort y = ct; y <= cb; ++y) {
+        for (GLshort x = cl; x <= cr; ++x) {
+            cells[y * depth_columns + x] = depth;
+        }
+    }
+
+    return depth;
+}
+
+void GraphicsGL::evict_page(std::uint8_t page)
+{
+    AtlasPage& atlas_page = pages[page];
+    for (std::size_t id : atlas_page.bitmaps) {
+        if (auto iter = offsets.find(id); iter != offsets.end()) {
+            iter->second.resident = false;
+        }
+    }
+
+    atlas_stats.evictions += atlas_page.bitmaps.size();
+    atlas_stats.resident_bytes -= atlas_page.resident_bytes;
+
+    atlas_page.bitmaps.clear();
+    atlas_page.resident_bytes = 0;
+    ++atlas_page.generation;
+    atlas_page.reset(page == 0 ? font_y_max : 1);
+}
+
+std::uint64_t GraphicsGL::live_frame() const noexcept
+{
+    // While locked, the scene drawn before locking is shown again. It may
+    // have been recorded during the frame before `lock()` was called.
+    if (locked) {
+        return std::min(frame, locked_frame > 0 ? locked_frame - 1 : 0);
+    }
+
+    return frame;
+}
+
+std::uint8_t GraphicsGL::find_cold_page(std::uint64_t before) const noexcept
+{
+    std::uint8_t coldest = NULL_PAGE;
+    for (std::uint8_t i = 0; i < pages.size(); ++i) {
+        const AtlasPage& atlas_page = pages[i];
+        if (atlas_page.bitmaps.empty() || atlas_page.pinned
+            || atlas_page.last_used >= before) {
+            continue;
+        }
+
+        if (coldest == NULL_PAGE
+            || atlas_page.last_used < pages[coldest].last_used) {
+            coldest = i;
+        }
+    }
+
+    return coldest;
+}
+
+float GraphicsGL::atlas_usage() const noexcept
+{
+    float used = 0.0f;
+    for (const AtlasPage& atlas_page : pages) {
+        used += atlas_page.usage();
+    }
+
+    return used / MAX_PAGES;
+}
+
+GraphicsGL::AtlasPage::AtlasPage()
+    : texture{0},
+      last_used{0},
+      generation{0},
+      pinned{false},
+      resident_bytes{0},
+      leftovers{[](const Leftover& first, const Leftover& second) {
+          bool wcomp = first.width() >= second.width();
+          bool hcomp = first.height() >= second.height();
+          if (wcomp && hcomp) {
+              return QuadTree<std::size_t, Leftover>::RIGHT;
+          } else if (wcomp) {
+              return QuadTree<std::size_t, Leftover>::DOWN;
+          } else if (hcomp) {
+              return QuadTree<std::size_t, Leftover>::UP;
+          } else {
+              return QuadTree<std::size_t, Leftover>::LEFT;
+          }
+      }},
+      rlid{1},
+      wasted{0}
+{
+}
+
+void GraphicsGL::AtlasPage::reset(GLshort reserved)
+{
+    leftovers.clear();
+    rlid = 1;
+    wasted = 0;
+    border = {0, reserved};
+    y_range = {};
+}
+
+bool GraphicsGL::AtlasPage::allocate(GLshort w,
+                                     GLshort h,
+                                     GLshort& x,
+                                     GLshort& y)
+{
+    auto value = Leftover(0, 0, w, h);
+    std::size_t lid = leftovers.find_node(value, [
+    ](const Leftover& val, const Leftover& leaf) noexcept {
+        return val.width() <= leaf.width() && val.height() <= leaf.height();
+    });
+
+    if (lid > 0) {
+        const Leftover& leftover = leftovers[lid];
+
+        x = leftover.l;
+        y = leftover.t;
+
+        GLshort wdelta = leftover.width() - w;
+        GLshort hdelta = leftover.height() - h;
+
+        leftovers.erase(lid);
+
+        wasted -= w * h;
+
+        if (wdelta >= MINLOSIZE && hdelta >= MINLOSIZE) {
+            leftovers.add(rlid, Leftover(x + w, y + h, wdelta, hdelta));
+            ++rlid;
+
+            if (w >= MINLOSIZE) {
+                leftovers.add(rlid, Leftover(x, y + h, w, hdelta));
+                ++rlid;
+            }
+
+            if (h >= MINLOSIZE) {
+                leftovers.add(rlid, Leftover(x + w, y, wdelta, h));
+                ++rlid;
+            }
+        } else if (wdelta >= MINLOSIZE) {
+            leftovers.add(rlid, Leftover(x + w, y, wdelta, h + hdelta));
+            ++rlid;
+        } else if (hdelta >= MINLOSIZE) {
+            leftovers.add(rlid, Leftover(x, y + h, w + wdelta, hdelta));
+            ++rlid;
+        }
+
+        return true;
+    }
+
+    if (border.x() + w > ATLASW) {
+        GLshort next_row = border.y() + y_range.second();
+        if (next_row + h > ATLASH) {
+            return false;
+        }
+
+        border = {0, next_row};
+        y_range = Range<GLshort>();
+    } else if (border.y() + h > ATLASH) {
+        return false;
+    }
+
+    x = border.x();
+    y = border.y();
+
+    border.shift_x(w);
+
+    if (h > y_range.second()) {
+        if (x >= MINLOSIZE && h - y_range.second() >= MINLOSIZE) {
+            leftovers.add(
+                rlid, Leftover(0, y_range.first(), x, h - y_range.second()));
+            ++rlid;
+        }
+
+        wasted += x * (h - y_range.second());
+
+        y_range = {y + h, h};
+    } else if (h < y_range.first() - y) {
+        if (w >= MINLOSIZE && y_range.first() - y - h >= MINLOSIZE) {
+            leftovers.add(rlid,
+                          Leftover(x, y + h, w, y_range.first() - y - h));
+            ++rlid;
+        }
+
+        wasted += w * (y_range.first() - y - h);
+    }
+
+    return true;
+}
+
+float GraphicsGL::AtlasPage::usage() const noexcept
+{
+    std::size_t used = ATLASW * border.y() + border.x() * y_range.second();
+    return static_cast<float>(used) / static_cast<float>(ATLASW * ATLASH);
+}
+
+void GraphicsGL::draw(const WzBitmap& bmp,
+                      const Rectangle<std::int16_t>& rect,
+                      const Color& color,
+                      float angle)
+{
+    if (recording_static || recording_composite) {
+        if (!color.invisible()) {
+            recording.push_back({bmp, rect, color, angle});
+        }
+
+        return;
+    }
+
+    if (locked) {
+        return;
+    }
+
+    if (color.invisible()) {
+        return;
+    }
+
+    if (!rect.overlaps(screen)) {
+        return;
+    }
+
+    const AtlasEntry& entry = get_entry(bmp);
+    if (entry.page != NULL_PAGE) {
+        use_page(entry.page);
+    }
+
+    add_quad(
+        {rect.l(), rect.r(), rect.t(), rect.b(), entry.offset, color, angle},
+        entry.page);
+}
+
+void GraphicsGL::begin_static()
+{
+    recording_static = true;
+    recording.clear();
+}
+
+GraphicsGL::StaticId GraphicsGL::end_static()
+{
+    recording_static = false;
+
+    StaticId id = next_static++;
+    StaticBuffer& batch = static_batches[id];
+    batch.sources = std::move(recording);
+    recording.clear();
+
+    // Assign every quad to each chunk it overlaps, so that a chunk lists
+    // all quads needed to draw it.
+    if (!batch.sources.empty()) {
+        std::int16_t l = batch.sources[0].rect.l();
+        std::int16_t r = batch.sources[0].rect.r();
+        std::int16_t t = batch.sources[0].rect.t();
+        std::int16_t b = batch.sources[0].rect.b();
+        for (const StaticQuad& quad : batch.sources) {
+            l = std::min(l, quad.rect.l());
+            r = std::max(r, quad.rect.r());
+            t = std::min(t, quad.rect.t());
+            b = std::max(b, quad.rect.b());
+        }
+
+        batch.origin = {l, t};
+        batch.columns = static_cast<std::int16_t>((r - l) / STATIC_CHUNK + 1);
+        batch.rows = static_cast<std::int16_t>((b - t) / STATIC_CHUNK + 1);
+        batch.chunks.resize(static_cast<std::size_t>(batch.columns)
+                            * static_cast<std::size_t>(batch.rows));
+
+        for (std::uint32_t i = 0; i < batch.sources.size(); ++i) {
+            const Rectangle<std::int16_t>& rect = batch.sources[i].rect;
+            std::int16_t cl = (rect.l() - l) / STATIC_CHUNK;
+            std::int16_t cr = (rect.r() - l) / STATIC_CHUNK;
+            std::int16_t ct = (rect.t() - t) / STATIC_CHUNK;
+            std::int16_t cb = (rect.b() - t) / STATIC_CHUNK;
+            for (std::int16_t y = ct; y <= cb; ++y) {
+                for (std::int16_t x = cl; x <= cr; ++x) {
+                    batch.chunks[y * batch.columns + x].push_back(i);
+                }
+            }
+        }
+    }
+
+    glGenBuffers(1, &batch.vbo);
+    batch.immediate = !upload_static(batch);
+    batch.retry = frame + STATIC_RETRY_DELAY;
+
+    return id;
+}
+
+void GraphicsGL::draw_static(StaticId id, Point<std::int16_t> offset)
+{
+    if (locked) {
+        return;
+    }
+
+    auto iter = static_batches.find(id);
+    if (iter == static_batches.end()) {
+        return;
+    }
+
+    StaticBuffer& batch = iter->second;
+
+    // Bitmaps move when the atlas page they were in is evicted. A batch
+    // which is evicted again right after being uploaded competes with other
+    // bitmaps for the atlas, and is drawn immediately for a while.
+    if (batch.immediate) {
+        if (frame >= batch.retry) {
+            batch.immediate = !upload_static(batch);
+            batch.retry = frame + STATIC_RETRY_DELAY;
+        }
+    } else {
+        for (std::uint8_t page : batch.used_pages) {
+            if (page < pages.size()
+                && pages[page].generation != batch.generations[page]) {
+                batch.immediate
+                    = batch.uploaded + 1 >= frame || !upload_static(batch);
+                batch.retry = frame + STATIC_RETRY_DELAY;
+                break;
+            }
+        }
+    }
+
+    if (batch.chunks.empty()) {
+        return;
+    }
+
+    // Find the range of chunks on screen.
+    auto chunk = [](std::int16_t pos, std::int16_t count) {
+        return std::clamp(static_cast<std::int16_t>(pos / STATIC_CHUNK),
+                          static_cast<std::int16_t>(0),
+                          static_cast<std::int16_t>(count - 1));
+    };
+
+    Point<std::int16_t> shift = batch.origin + offset;
+    std::int16_t left = screen.l() - shift.x();
+    std::int16_t right = screen.r() - shift.x();
+    std::int16_t top = screen.t() - shift.y();
+    std::int16_t bottom = screen.b() - shift.y();
+    if (right < 0 || bottom < 0 || left > batch.columns * STATIC_CHUNK
+        || top > batch.rows * STATIC_CHUNK) {
+        return;
+    }
+
+    Rectangle<std::int16_t> visible{chunk(left, batch.columns),
+                                    chunk(right, batch.columns),
+                                    chunk(top, batch.rows),
+                                    chunk(bottom, batch.rows)};
+
+    if (batch.immediate) {
+        draw_static_immediate(batch, visible, offset);
+        return;
+    }
+
+    // The quads to draw only change when the camera crosses into another
+    // chunk. They are merged in drawing order, so that overlapping quads
+    // from neighbouring chunks stay in the right order.
+    if (batch.runs.empty() || visible.get_lt() != batch.visible.get_lt()
+        || visible.get_rb() != batch.visible.get_rb()) {
+        find_shown_static(batch, visible);
+
+        batch.visible = visible;
+        batch.runs.clear();
+        for (std::uint32_t i = 0; i < static_shown.size(); ++i) {
+            if (!static_shown[i]) {
+                continue;
+            }
+
+            std::uint8_t page = batch.quad_pages[i];
+            if (!batch.runs.empty()) {
+                StaticRun& last = batch.runs.back();
+                if (last.page == page && last.first + last.count == i) {
+                    ++last.count;
+                    continue;
+                }
+            }
+
+            batch.runs.push_back({page, i, 1});
+        }
+    }
+
+    for (const StaticRun& run : batch.runs) {
+        use_page(run.page);
+    }
+
+    // Static batches may cover the whole screen, so nothing is moved across
+    // them.
+    std::uint32_t depth = claim_depth(screen.l(),
+                                      screen.r(),
+                                      screen.t(),
+                                      screen.b());
+    std::uint64_t key = static_cast<std::uint64_t>(draw_layer) << 56
+                        | static_cast<std::uint64_t>(depth) << 24
+                        | static_cast<std::uint64_t>(draw_blend) << 16;
+
+    auto index = static_cast<std::uint32_t>(static_draws.size());
+    commands.push_back({key, index | STATIC_COMMAND});
+    static_draws.push_back({id, offset});
+}
+
+void GraphicsGL::free_static(StaticId id)
+{
+    if (id == NULL_STATIC) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard{queue_mutex};
+    freed_static.push_back(id);
+}
+
+void GraphicsGL::free_queued_static()
+{
+    std::lock_guard<std::mutex> guard{queue_mutex};
+    for (StaticId id : freed_static) {
+        if (auto iter = static_batches.find(id);
+            iter != static_batches.end()) {
+            glDeleteBuffers(1, &iter->second.vbo);
+            static_batches.erase(iter);
+        }
+    }
+
+    freed_static.clear();
+}
+
+bool GraphicsGL::upload_static(StaticBuffer& batch)
+{
+    std::vector<Quad> vertices;
+    vertices.reserve(batch.sources.size());
+    batch.quad_pages.clear();
+
+    // Pages holding bitmaps of this batch must not be evicted to make room
+    // for the rest of it.
+    atlas_full = false;
+    for (const StaticQuad& quad : batch.sources) {
+        const AtlasEntry& entry = get_entry(quad.bitmap);
+        if (entry.page != NULL_PAGE) {
+            pages[entry.page].pinned = true;
+            pages[entry.page].last_used = frame;
+        }
+
+        const Rectangle<std::int16_t>& rect = quad.rect;
+        vertices.emplace_back(rect.l(),
+                              rect.r(),
+                              rect.t(),
+                              rect.b(),
+                              entry.offset,
+                              quad.color,
+                              quad.angle);
+        batch.quad_pages.push_back(entry.page == NULL_PAGE ? 0 : entry.page);
+    }
+
+    batch.used_pages = batch.quad_pages;
+    std::sort(batch.used_pages.begin(), batch.used_pages.end());
+    batch.used_pages.erase(
+        std::unique(batch.used_pages.begin(), batch.used_pages.end()),
+        batch.used_pages.end());
+
+    batch.generations.clear();
+    for (AtlasPage& atlas_page : pages) {
+        batch.generations.push_back(atlas_page.generation);
+        atlas_page.pinned = false;
+    }
+
+    batch.runs.clear();
+    batch.uploaded = frame;
+
+    if (backend == MODERN) {
+        reserve_indices(vertices.size());
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(vertices.size() * sizeof(Quad)),
+                 vertices.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return !atlas_full;
+}
+
+void GraphicsGL::find_shown_static(const StaticBuffer& batch,
+                                   const Rectangle<std::int16_t>& visible)
+{
+    static_shown.assign(batch.sources.size(), false);
+    for (std::int16_t y = visible.t(); y <= visible.b(); ++y) {
+        for (std::int16_t x = visible.l(); x <= visible.r(); ++x) {
+            for (std::uint32_t i : batch.chunks[y * batch.columns + x]) {
+                static_shown[i] = true;
+            }
+        }
+    }
+}
+
+void GraphicsGL::draw_static_immediate(const StaticBuffer& batch,
+                                       const Rectangle<std::int16_t>& visible,
+                                       Point<std::int16_t> offset)
+{
+    find_shown_static(batch, visible);
+
+    for (std::uint32_t i = 0; i < static_shown.size(); ++i) {
+        if (!static_shown[i]) {
+            continue;
+        }
+
+        const StaticQuad& quad = batch.sources[i];
+        Rectangle<std::int16_t> rect{
+            static_cast<std::int16_t>(quad.rect.l() + offset.x()),
+            static_cast<std::int16_t>(quad.rect.r() + offset.x()),
+            static_cast<std::int16_t>(quad.rect.t() + offset.y()),
+            static_cast<std::int16_t>(quad.rect.b() + offset.y())};
+        draw(quad.bitmap, rect, quad.color, quad.angle);
+    }
+}
+
+void GraphicsGL::draw_static_runs(StaticBuffer& batch,
+                                  Point<std::int16_t> offset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+    set_vertex_format();
+    glUniform2f(uniform_translation, offset.x(), offset.y());
+
+    for (const StaticRun& run : batch.runs) {
+        if (run.page != bound_page) {
+            bind_page(run.page);
+            ++frame_stats.texture_binds;
+        }
+
+        glUniform1i(uniform_font_region, run.page == 0 ? font_y_max : 0);
+        draw_quads(0, run.first, run.count);
+
+        frame_stats.quads += run.count;
+        ++frame_stats.draw_calls;
+    }
+
+    glUniform2f(uniform_translation, 0.0f, 0.0f);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    set_vertex_format();
+}
+
+bool GraphicsGL::begin_composite()
+{
+    if (recording_static || recording_composite || draw_blend != ALPHA) {
+        return false;
+    }
+
+    recording_composite = true;
+    recording.clear();
+
+    return true;
+}
+
+GraphicsGL::CompositeId GraphicsGL::end_composite()
+{
+    recording_composite = false;
+
+    std::vector<StaticQuad> sources = std::move(recording);
+    recording.clear();
+
+    if (sources.empty() || composites_full) {
+        return NULL_COMPOSITE;
+    }
+
+    // Mirrored bitmaps have their left and right edges swapped.
+    const Rectangle<std::int16_t>& first = sources[0].rect;
+    std::int16_t l = std::min(first.l(), first.r());
+    std::int16_t r = std::max(first.l(), first.r());
+    std::int16_t t = std::min(first.t(), first.b());
+    std::int16_t b = std::max(first.t(), first.b());
+    for (const StaticQuad& quad : sources) {
+        l = std::min({l, quad.rect.l(), quad.rect.r()});
+        r = std::max({r, quad.rect.l(), quad.rect.r()});
+        t = std::min({t, quad.rect.t(), quad.rect.b()});
+        b = std::max({b, quad.rect.t(), quad.rect.b()});
+    }
+
+    GLshort w = r - l;
+    GLshort h = b - t;
+    if (w <= 0 || h <= 0 || w > ATLASW || h > ATLASH) {
+        return NULL_COMPOSITE;
+    }
+
+    GLshort x = 0;
+    GLshort y = 0;
+    if (!composite_page.allocate(w, h, x, y)) {
+        composites_full = true;
+        return NULL_COMPOSITE;
+    }
+
+    CompositeId id = next_composite++;
+    Composite& composite = composites[id];
+    composite.offset = {x, y, w, h};
+    composite.origin = {static_cast<std::int16_t>(-l),
+                        static_cast<std::int16_t>(-t)};
+    composite.dimensions = {w, h};
+    composite.sources = std::move(sources);
+    pending_composites.push_back(id);
+
+    return id;
+}
+
+bool GraphicsGL::draw_composite(CompositeId id, const DrawArgument& args)
+{
+    if (recording_static || recording_composite || draw_blend != ALPHA) {
+        return false;
+    }
+
+    auto iter = composites.find(id);
+    if (iter == composites.end()) {
+        return false;
+    }
+
+    const Color& color = args.get_color();
+    if (locked || color.invisible()) {
+        return true;
+    }
+
+    const Composite& composite = iter->second;
+    Rectangle<std::int16_t> rect
+        = args.get_rectangle(composite.origin, composite.dimensions);
+    if (!rect.overlaps(screen)) {
+        return true;
+    }
+
+    Color premultiplied{color.r() * color.a(),
+                        color.g() * color.a(),
+                        color.b() * color.a(),
+                        color.a()};
+
+    draw_blend = PREMULTIPLIED;
+    add_quad({rect.l(),
+              rect.r(),
+              rect.t(),
+              rect.b(),
+              composite.offset,
+              premultiplied,
+              args.get_angle()},
+             COMPOSITE_PAGE);
+    draw_blend = ALPHA;
+
+    return true;
+}
 
-    if (w <= 0 || h <= 0) {
-        return null_offset;
+void GraphicsGL::free_composite(CompositeId id)
+{
+    if (id == NULL_COMPOSITE) {
+        return;
     }
 
+    std::lock_guard<std::mutex> guard{queue_mutex};
+    freed_composites.push_back(id);
+}
 
-    auto bmp_data = bmp.input.data();
-    if (!bmp_data) {
-        return null_offset;
+void GraphicsGL::free_queued_composites()
+{
+    // The space of a freed image is only reused once the whole page is
+    // emptied.
+    std::lock_guard<std::mutex> guard{queue_mutex};
+    for (CompositeId id : freed_composites) {
+        composites.erase(id);
     }
 
-    auto value = Leftover(x, y, w, h);
-    std::size_t lid = leftovers.find_node(value, [
-    ](const Leftover& val, const Leftover& leaf) noexcept {
-        return val.width() <= leaf.width() && val.height() <= leaf.height();
-    });
-
-    if (lid > 0) {
-        const Leftover& leftover = leftovers[lid];
+    freed_composites.clear();
+}
 
-        x = leftover.l;
-        y = leftover.t;
+void GraphicsGL::reset_composites()
+{
+    composites.clear();
+    pending_composites.clear();
+    composite_page.reset(1);
+    ++composite_page.generation;
+    composites_full = false;
+}
 
-        GLshort wdelta = leftover.width() - w;
-        GLshort hdelta = leftover.height() - h;
+std::size_t GraphicsGL::render_composites()
+{
+    if (pending_composites.empty()) {
+        return 0;
+    }
 
-        leftovers.erase(lid);
+    if (composite_fbo == 0) {
+        glGenTextures(1, &composite_page.texture);
+        glBindTexture(GL_TEXTURE_2D, composite_page.texture);
+        bound_page = COMPOSITE_PAGE;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D,
+                     0,
+                     GL_RGBA,
+                     ATLASW,
+                     ATLASH,
+                     0,
+                     GL_RGBA,
+                     GL_UNSIGNED_BYTE,
+                     nullptr);
+
+        glGenBuffers(1, &composite_vbo);
+        glGenFramebuffers(1, &composite_fbo);
+    }
 
-        wasted -= w * h;
+    // Look up the bitmaps of every image first, as that may upload them.
+    std::vector<const Composite*> rendering;
+    std::vector<Quad> vertices;
+    std::vector<StaticRun> runs;
+    std::vector<std::size_t> first_runs;
+    for (CompositeId id : pending_composites) {
+        auto iter = composites.find(id);
+        if (iter == composites.end()) {
+            continue;
+        }
 
-        if (wdelta >= MINLOSIZE && hdelta >= MINLOSIZE) {
-            leftovers.add(rlid, Leftover(x + w, y + h, wdelta, hdelta));
-            ++rlid;
+        Composite& composite = iter->second;
+        rendering.push_back(&composite);
+        first_runs.push_back(runs.size());
 
-            if (w >= MINLOSIZE) {
-                leftovers.add(rlid, Leftover(x, y + h, w, hdelta));
-                ++rlid;
+        for (const StaticQuad& quad : composite.sources) {
+            const AtlasEntry& entry = get_entry(quad.bitmap);
+            if (entry.page == NULL_PAGE) {
+                continue;
             }
 
-            if (h >= MINLOSIZE) {
-                leftovers.add(rlid, Leftover(x + w, y, wdelta, h));
-                ++rlid;
-            }
-        } else if (wdelta >= MINLOSIZE) {
-            leftovers.add(rlid, Leftover(x + w, y, wdelta, h + hdelta));
-            ++rlid;
-        } else if (hdelta >= MINLOSIZE) {
-            leftovers.add(rlid, Leftover(x, y + h, w + wdelta, hdelta));
-            ++rlid;
-        }
-    } else {
-        if (border.x() + w > ATLASW) {
-            border.set_x(0);
-            border.shift_y(y_range.second());
-            if (border.y() + h > ATLASH) {
-                clear_internal();
+            use_page(entry.page);
+
+            const Rectangle<std::int16_t>& rect = quad.rect;
+            std::size_t index = vertices.size();
+            vertices.emplace_back(rect.l(),
+                                  rect.r(),
+                                  rect.t(),
+                                  rect.b(),
+                                  entry.offset,
+                                  quad.color,
+                                  quad.angle);
+
+            if (runs.size() > first_runs.back()
+                && runs.back().page == entry.page) {
+                ++runs.back().count;
             } else {
-                y_range = Range<GLshort>();
+                runs.push_back({entry.page, index, 1});
             }
         }
-        x = border.x();
-        y = border.y();
-
-        border.shift_x(w);
 
-        if (h > y_range.second()) {
-            if (x >= MINLOSIZE && h - y_range.second() >= MINLOSIZE) {
-                leftovers.add(
-                    rlid,
-                    Leftover(0, y_range.first(), x, h - y_range.second()));
-                ++rlid;
-            }
-
-            wasted += x * (h - y_range.second());
+        composite.sources = {};
+    }
 
-            y_range = {y + h, h};
-        } else if (h < y_range.first() - y) {
-            if (w >= MINLOSIZE && y_range.first() - y - h >= MINLOSIZE) {
-                leftovers.add(rlid,
-                              Leftover(x, y + h, w, y_range.first() - y - h));
-                ++rlid;
-            }
+    first_runs.push_back(runs.size());
+    pending_composites.clear();
+
+    // The scene may be drawn into another framebuffer than the window's,
+    // such as the one of the headless benchmark.
+    GLint target = 0;
+    GLint viewport[4];
+    GLfloat screen_size[2];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetUniformfv(program, uniform_screen_size, screen_size);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, composite_fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER,
+                           GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D,
+                           composite_page.texture,
+                           0);
+
+    if (backend == MODERN) {
+        reserve_indices(vertices.size());
+    } else {
+        glEnableVertexAttribArray(attribute_coord);
+        glEnableVertexAttribArray(attribute_color);
+    }
 
-            wasted += w * (y_range.first() - y - h);
+    glBindBuffer(GL_ARRAY_BUFFER, composite_vbo);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(vertices.size() * sizeof(Quad)),
+                 vertices.data(),
+                 GL_STREAM_DRAW);
+    set_vertex_format();
+
+    // Blending the alpha channel additively makes the layers of an image
+    // add up to the coverage of the whole, which leaves the colors
+    // multiplied by the alpha.
+    glBlendFuncSeparate(
+        GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_SCISSOR_TEST);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    for (std::size_t i = 0; i < rendering.size(); ++i) {
+        const Composite& composite = *rendering[i];
+        const Offset& offset = composite.offset;
+        GLsizei w = offset.r - offset.l;
+        GLsizei h = offset.b - offset.t;
+
+        // Texture rows grow downwards from the top of the image, so the
+        // vertical axis is flipped compared to the screen.
+        glViewport(offset.l, offset.t, w, h);
+        glScissor(offset.l, offset.t, w, h);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glUniform2f(uniform_screen_size,
+                    static_cast<GLfloat>(w),
+                    static_cast<GLfloat>(-h));
+        glUniform1i(uniform_y_offset, -h);
+        glUniform2f(uniform_translation,
+                    composite.origin.x(),
+                    composite.origin.y());
+
+        for (std::size_t j = first_runs[i]; j < first_runs[i + 1]; ++j) {
+            const StaticRun& run = runs[j];
+            bind_page(run.page);
+            glUniform1i(uniform_font_region, run.page == 0 ? font_y_max : 0);
+            draw_quads(0, run.first, run.count);
         }
     }
 
-    /*
-    std::size_t used = ATLASW * border.y() + border.x() * y_range.second();
-    double usedpercent = static_cast<double>(used) / (ATLASW * ATLASH);
-    double wastedpercent = static_cast<double>(wasted) / used;
-    Console::get().print("Used: " + std::to_string(usedpercent) + ", wasted: "
-    + std::to_string(wastedpercent));
-    */
-
-    glTexSubImage2D(
-        GL_TEXTURE_2D, 0, x, y, w, h, GL_BGRA, GL_UNSIGNED_BYTE, bmp_data);
+    glDisable(GL_SCISSOR_TEST);
+    apply_blend(bound_blend);
 
-    return offsets
-        .emplace(std::piecewise_construct,
-                 std::forward_as_tuple(id),
-                 std::forward_as_tuple(x, y, w, h))
-        .first->second;
-}
+    glUniform2f(uniform_screen_size, screen_size[0], screen_size[1]);
+    glUniform1i(uniform_y_offset, Constants::VIEW_Y_OFFSET);
+    glUniform2f(uniform_translation, 0.0f, 0.0f);
 
-void GraphicsGL::draw(const WzBitmap& bmp,
-                      const Rectangle<std::int16_t>& rect,
-                      const Color& color,
-                      float angle)
-{
-    if (locked) {
-        return;
-    }
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(target));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 
-    if (color.invisible()) {
-        return;
+    if (backend == LEGACY) {
+        glDisableVertexAttribArray(attribute_coord);
+        glDisableVertexAttribArray(attribute_color);
     }
 
-    if (!rect.overlaps(screen)) {
-        return;
-    }
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    set_vertex_format();
 
-    quads.emplace_back(
-        rect.l(), rect.r(), rect.t(), rect.b(), get_offset(bmp), color, angle);
+    return rendering.size();
 }
 
 Text::Layout GraphicsGL::create_layout(const utf8_string& text,
@@ -496,6 +1478,25 @@ Text::Layout GraphicsGL::create_layout(const utf8_string& text,
         return {};
     }
 
+    if (max_width == 0) {
+        max_width = Window::get().get_width();
+    }
+
+    // Texts are laid out again whenever they change, so layouts of texts
+    // which were seen before are reused.
+    LayoutKey key{std::hash<std::string_view>{}(
+                      std::string_view{text.data(), text.size()}),
+                  id,
+                  alignment,
+                  max_width,
+                  formatted};
+    auto [iter, added] = layouts.try_emplace(key);
+    CachedLayout& cached = iter->second;
+    cached.last_used = frame;
+    if (!added && cached.text == text) {
+        return cached.layout;
+    }
+
     LayoutBuilder builder{fonts[id], alignment, max_width, formatted};
 
     utf8_string::size_type first = 0;
@@ -513,7 +1514,10 @@ Text::Layout GraphicsGL::create_layout(const utf8_string& text,
     first = builder.add(text, first, offset, length);
     offset = length;
 
-    return builder.finish(first, offset);
+    cached.text = text;
+    cached.layout = builder.finish(text, first, offset);
+
+    return cached.layout;
 }
 
 GraphicsGL::LayoutBuilder::LayoutBuilder(Font& f,
@@ -528,9 +1532,6 @@ GraphicsGL::LayoutBuilder::LayoutBuilder(Font& f,
     ay = font.line_space();
     width = 0;
     endy = 0;
-    if (max_width == 0) {
-        max_width = Window::get().get_width();
-    }
 }
 
 utf8_string::size_type
@@ -650,14 +1651,20 @@ GraphicsGL::LayoutBuilder::add(const utf8_string& text,
     }
 }
 
-Text::Layout GraphicsGL::LayoutBuilder::finish(std::size_t first,
+Text::Layout GraphicsGL::LayoutBuilder::finish(const utf8_string& text,
+                                               std::size_t first,
                                                std::size_t last)
 {
     add_word(first, last, font_id, color);
     add_line();
 
     advances.push_back(ax);
-    return {lines, advances, width, ay, ax, endy};
+
+    for (Text::Layout::Line& line : lines) {
+        add_glyphs(text, line);
+    }
+
+    return {std::move(lines), std::move(advances), width, ay, ax, endy};
 }
 
 void GraphicsGL::LayoutBuilder::add_word(std::size_t word_first,
@@ -687,6 +1694,66 @@ void GraphicsGL::LayoutBuilder::add_line()
     words.clear();
 }
 
+void GraphicsGL::LayoutBuilder::add_glyphs(const utf8_string& text,
+                                           Text::Layout::Line& line)
+{
+    std::int16_t left = 0;
+    std::int16_t right = 0;
+    std::int16_t top = 0;
+    std::int16_t bottom = 0;
+
+    for (const Text::Layout::Word& word : line.words) {
+        std::int16_t gx
+            = line.position.x()
+              + (word.first < advances.size() ? advances[word.first] : 0);
+        std::int16_t gy = line.position.y();
+
+        for (auto pos = word.first; pos < word.last; ++pos) {
+            const auto c = text[pos];
+            const auto font_char = font.get_or_insert_char(c);
+            if (!font_char) {
+                continue;
+            }
+            const Font::Char& ch = *font_char;
+
+            if (gx == 0 && c == U' ') { // TODO: i18n
+                continue;
+            }
+
+            auto chx = static_cast<std::int16_t>(gx + ch.bl);
+            auto chy = static_cast<std::int16_t>(gy - ch.bt);
+
+            gx += ch.ax;
+
+            if (ch.bw <= 0 || ch.bh <= 0) {
+                continue;
+            }
+
+            auto chr = static_cast<std::int16_t>(chx + ch.bw);
+            auto chb = static_cast<std::int16_t>(chy + ch.bh);
+            Rectangle<std::int16_t> bounds{chx, chr, chy, chb};
+            Rectangle<std::int16_t> source{
+                ch.offset.l, ch.offset.r, ch.offset.t, ch.offset.b};
+
+            if (line.glyphs.empty()) {
+                left = bounds.l();
+                right = bounds.r();
+                top = bounds.t();
+                bottom = bounds.b();
+            } else {
+                left = std::min(left, bounds.l());
+                right = std::max(right, bounds.r());
+                top = std::min(top, bounds.t());
+                bottom = std::max(bottom, bounds.b());
+            }
+
+            line.glyphs.push_back({bounds, source, word.color});
+        }
+    }
+
+    line.bounds = {left, right, top, bottom};
+}
+
 void GraphicsGL::draw_text(const DrawArgument& args,
                            const utf8_string& text,
                            const Text::Layout& layout,
@@ -720,22 +1787,24 @@ void GraphicsGL::draw_text(const DrawArgument& args,
             GLshort bottom = top + h - 2;
             Color ntcolor{0.0f, 0.0f, 0.0f, 0.6f};
 
-            quads.emplace_back(
-                left, right, top, bottom, null_offset, ntcolor, 0.0f);
-            quads.emplace_back(left - 1,
-                               left,
-                               top + 1,
-                               bottom - 1,
-                               null_offset,
-                               ntcolor,
-                               0.0f);
-            quads.emplace_back(right,
-                               right + 1,
-                               top + 1,
-                               bottom - 1,
-                               null_offset,
-                               ntcolor,
-                               0.0f);
+            add_quad({left, right, top, bottom, null_offset, ntcolor, 0.0f},
+                     NULL_PAGE);
+            add_quad({left - 1,
+                      left,
+                      top + 1,
+                      bottom - 1,
+                      null_offset,
+                      ntcolor,
+                      0.0f},
+                     NULL_PAGE);
+            add_quad({right,
+                      right + 1,
+                      top + 1,
+                      bottom - 1,
+                      null_offset,
+                      ntcolor,
+                      0.0f},
+                     NULL_PAGE);
         }
         break;
     default:
@@ -757,46 +1826,53 @@ void GraphicsGL::draw_text(const DrawArgument& args,
         {0.5f, 0.0f, 0.5f}     // Violet
     };
 
-    for (const Text::Layout::Line& line : layout) {
-        Point<std::int16_t> position = line.position;
-
-        for (const Text::Layout::Word& word : line.words) {
-            GLshort ax = position.x() + layout.advance(word.first);
-            GLshort ay = position.y();
-
-            const GLfloat* const wordcolor = word.color < Text::NUM_COLORS
-                                                 ? colors[word.color]
-                                                 : colors[colorid];
-            Color abscolor
-                = color
-                  * Color{wordcolor[0], wordcolor[1], wordcolor[2], 1.0f};
-
-            for (auto pos = word.first; pos < word.last; ++pos) {
-                const auto c = text[pos];
-                const auto font_char = font.get_or_insert_char(c);
-                if (!font_char) {
-                    continue;
-                }
-                const Font::Char& ch = *font_char;
-
-                GLshort chx = x + ax + ch.bl;
-                GLshort chy = y + ay - ch.bt;
-                GLshort chw = ch.bw;
-                GLshort chh = ch.bh;
-
-                if (ax == 0 && c == U' ') { // TODO: i18n
-                    continue;
-                }
+    // Colors are packed once per text, instead of once per glyph.
+    std::array<std::uint8_t, Color::LENGTH> packed[Text::NUM_COLORS];
+    bool is_packed[Text::NUM_COLORS] = {};
 
-                ax += ch.ax;
+    use_page(0);
 
-                if (chw <= 0 || chh <= 0) {
-                    continue;
-                }
+    for (const Text::Layout::Line& line : layout) {
+        if (line.glyphs.empty()) {
+            continue;
+        }
 
-                quads.emplace_back(
-                    chx, chx + chw, chy, chy + chh, ch.offset, abscolor, 0.0f);
+        // The glyphs of a line do not overlap each other, so they all share
+        // the depth of the rectangle covering them.
+        const Rectangle<std::int16_t>& bounds = line.bounds;
+        std::uint64_t key
+            = static_cast<std::uint64_t>(draw_layer) << 56
+              | static_cast<std::uint64_t>(claim_depth(x + bounds.l(),
+                                                       x + bounds.r(),
+                                                       y + bounds.t(),
+                                                       y + bounds.b()))
+                    << 24
+              | static_cast<std::uint64_t>(draw_blend) << 16;
+
+        for (const Text::Layout::Glyph& glyph : line.glyphs) {
+            Text::Color glyph_color
+                = glyph.color < Text::NUM_COLORS ? glyph.color : colorid;
+            if (!is_packed[glyph_color]) {
+                const GLfloat* const rgb = colors[glyph_color];
+                packed[glyph_color] = Quad::pack(
+                    color * Color{rgb[0], rgb[1], rgb[2], 1.0f});
+                is_packed[glyph_color] = true;
             }
+
+            const Rectangle<std::int16_t>& source = glyph.source;
+            Offset offset{source.l(),
+                          source.t(),
+                          source.width(),
+                          source.height()};
+
+            auto index = static_cast<std::uint32_t>(quads.size());
+            commands.push_back({key, index});
+            quads.emplace_back(x + glyph.bounds.l(),
+                               x + glyph.bounds.r(),
+                               y + glyph.bounds.t(),
+                               y + glyph.bounds.b(),
+                               offset,
+                               packed[glyph_color]);
         }
     }
 }
@@ -814,8 +1890,8 @@ void GraphicsGL::draw_rectangle(std::int16_t x,
         return;
     }
 
-    quads.emplace_back(
-        x, x + w, y, y + h, null_offset, Color{r, g, b, a}, 0.0f);
+    add_quad({x, x + w, y, y + h, null_offset, Color{r, g, b, a}, 0.0f},
+             NULL_PAGE);
 }
 
 void GraphicsGL::draw_screen_fill(float r, float g, float b, float a)
@@ -832,6 +1908,10 @@ void GraphicsGL::draw_screen_fill(float r, float g, float b, float a)
 
 void GraphicsGL::lock()
 {
+    if (!locked) {
+        locked_frame = frame;
+    }
+
     locked = true;
 }
 
@@ -842,44 +1922,355 @@ void GraphicsGL::unlock()
 
 void GraphicsGL::flush(float opacity)
 {
-    bool cover_scene = opacity != 1.0f;
-    if (cover_scene) {
+    ProfileScope scope{"GraphicsGL::flush"};
+
+    std::size_t composites_rendered = render_composites();
+
+    glClearColor(1.0, 1.0, 1.0, 1.0);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    build_batches();
+
+    // The fade covers everything, so it is drawn after the sorted batches
+    // instead of being sorted with the quads of the scene.
+    if (opacity != 1.0f) {
         float complement = 1.0f - opacity;
         Color color{0.0f, 0.0f, 0.0f, complement};
 
-        quads.emplace_back(screen.l(),
-                           screen.r(),
-                           screen.t(),
-                           screen.b(),
-                           null_offset,
-                           color,
-                           0.0f);
+        batches.push_back({NULL_PAGE, ALPHA, sorted_quads.size(), 1});
+        sorted_quads.push_back({screen.l(),
+                                screen.r(),
+                                screen.t(),
+                                screen.b(),
+                                null_offset,
+                                color,
+                                0.0f});
     }
 
-    glClearColor(1.0, 1.0, 1.0, 1.0);
-    glClear(GL_COLOR_BUFFER_BIT);
+    GLint base = 0;
+    if (backend == MODERN) {
+        base = upload_quads();
+    } else {
+        GLsizei csize
+            = static_cast<GLsizei>(sorted_quads.size() * sizeof(Quad));
+        glEnableVertexAttribArray(attribute_coord);
+        glEnableVertexAttribArray(attribute_color);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(
+            GL_ARRAY_BUFFER, csize, sorted_quads.data(), GL_STREAM_DRAW);
+    }
+
+    frame_stats = {};
+    frame_stats.quads = sorted_quads.size();
+    frame_stats.composites = composites_rendered;
+
+    for (const DrawBatch& batch : batches) {
+        if (batch.blend != bound_blend) {
+            apply_blend(batch.blend);
+            ++frame_stats.blend_changes;
+        }
+
+        if (batch.count == 0) {
+            const StaticDraw& static_draw = static_draws[batch.first];
+            if (auto iter = static_batches.find(static_draw.id);
+                iter != static_batches.end()) {
+                draw_static_runs(iter->second, static_draw.offset);
+            }
+
+            continue;
+        }
+
+        // Untextured quads may be drawn with any page bound.
+        if (batch.page != NULL_PAGE && batch.page != bound_page) {
+            bind_page(batch.page);
+            ++frame_stats.texture_binds;
+        }
+
+        // Only the first page holds glyphs.
+        glUniform1i(uniform_font_region, bound_page == 0 ? font_y_max : 0);
+        draw_quads(base, batch.first, batch.count);
+        ++frame_stats.draw_calls;
+    }
+
+    if (backend == MODERN) {
+        if (ring_data) {
+            // The segment may only be written again once the GPU is done.
+            ring_fences[ring_segment]
+                = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    } else {
+        glDisableVertexAttribArray(attribute_coord);
+        glDisableVertexAttribArray(attribute_color);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    if (composites_full) {
+        reset_composites();
+    }
+
+    if (frame % LAYOUT_PRUNE_INTERVAL == 0) {
+        for (auto iter = layouts.begin(); iter != layouts.end();) {
+            if (iter->second.last_used + LAYOUT_LIFETIME < frame) {
+                iter = layouts.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+    ++frame;
+}
+
+void GraphicsGL::build_batches()
+{
+    // Commands with equal keys never overlap, so their order does not
+    // matter.
+    std::sort(commands.begin(),
+              commands.end(),
+              [](const DrawCommand& a, const DrawCommand& b) {
+                  return a.key < b.key;
+              });
+
+    sorted_quads.clear();
+    batches.clear();
+
+    for (const DrawCommand& command : commands) {
+        auto blend = static_cast<Blend>((command.key >> 16) & 0xFF);
+
+        if (command.index & STATIC_COMMAND) {
+            std::size_t index = command.index & ~STATIC_COMMAND;
+            batches.push_back({NULL_PAGE, blend, index, 0});
+            continue;
+        }
+
+        auto page = static_cast<std::uint8_t>((command.key >> 8) & 0xFF);
+        if (!batches.empty()) {
+            DrawBatch& last = batches.back();
+            bool same_page = last.page == page || page == NULL_PAGE
+                             || last.page == NULL_PAGE;
+            if (last.count > 0 && last.blend == blend && same_page) {
+                if (last.page == NULL_PAGE) {
+                    last.page = page;
+                }
+
+                ++last.count;
+                sorted_quads.push_back(quads[command.index]);
+                continue;
+            }
+        }
+
+        batches.push_back({page, blend, sorted_quads.size(), 1});
+        sorted_quads.push_back(quads[command.index]);
+    }
+}
+
+void GraphicsGL::apply_blend(Blend mode)
+{
+    switch (mode) {
+    case ADDITIVE:
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        break;
+    case PREMULTIPLIED:
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    default:
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    }
 
-    GLsizei csize = static_cast<GLsizei>(quads.size() * sizeof(Quad));
-    GLsizei fsize = static_cast<GLsizei>(quads.size() * Quad::LENGTH);
-    glEnableVertexAttribArray(attribute_coord);
-    glEnableVertexAttribArray(attribute_color);
+    bound_blend = mode;
+}
+
+void GraphicsGL::set_layer(DrawLayer layer)
+{
+    draw_layer = layer;
+}
+
+void GraphicsGL::set_blend(Blend blend)
+{
+    draw_blend = blend;
+}
+
+const GraphicsGL::FrameStats& GraphicsGL::get_frame_stats() const noexcept
+{
+    return frame_stats;
+}
+
+void GraphicsGL::draw_quads(GLint base, std::size_t first, std::size_t count)
+{
+    if (backend == MODERN) {
+        // Every quad is drawn as two triangles from the shared index buffer.
+        auto offset = first * 6 * sizeof(GLuint);
+        glDrawElementsBaseVertex(GL_TRIANGLES,
+                                 static_cast<GLsizei>(count * 6),
+                                 GL_UNSIGNED_INT,
+                                 reinterpret_cast<const void*>(offset),
+                                 base);
+    } else {
+        glDrawArrays(GL_QUADS,
+                     base + static_cast<GLint>(first * Quad::LENGTH),
+                     static_cast<GLsizei>(count * Quad::LENGTH));
+    }
+}
+
+GLint GraphicsGL::upload_quads()
+{
+    std::size_t count = sorted_quads.size();
+    if (count > ring_capacity) {
+        resize_ring(count);
+    }
+
+    reserve_indices(count);
+
+    std::size_t bytes = count * sizeof(Quad);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, csize, quads.data(), GL_STREAM_DRAW);
-    glDrawArrays(GL_QUADS, 0, fsize);
 
-    glDisableVertexAttribArray(attribute_coord);
-    glDisableVertexAttribArray(attribute_color);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (ring_data) {
+        ring_segment = (ring_segment + 1) % RING_SEGMENTS;
+        if (GLsync fence = ring_fences[ring_segment]) {
+            while (glClientWaitSync(
+                       fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000)
+                   == GL_TIMEOUT_EXPIRED) {
+            }
+
+            glDeleteSync(fence);
+            ring_fences[ring_segment] = nullptr;
+        }
+
+        std::size_t first = ring_segment * ring_capacity;
+        std::memcpy(ring_data + first, sorted_quads.data(), bytes);
+        return static_cast<GLint>(first * Quad::LENGTH);
+    }
+
+    // Without persistent mapping, append to the buffer until it is full
+    // and then orphan it, so that the driver never waits for the GPU.
+    std::size_t total = ring_capacity * RING_SEGMENTS;
+    if (ring_offset + count > total) {
+        glBufferData(GL_ARRAY_BUFFER,
+                     static_cast<GLsizeiptr>(total * sizeof(Quad)),
+                     nullptr,
+                     GL_STREAM_DRAW);
+        ring_offset = 0;
+    }
+
+    std::size_t first = ring_offset;
+    if (bytes > 0) {
+        void* dest = glMapBufferRange(GL_ARRAY_BUFFER,
+                                      first * sizeof(Quad),
+                                      bytes,
+                                      GL_MAP_WRITE_BIT
+                                          | GL_MAP_INVALIDATE_RANGE_BIT
+                                          | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (dest) {
+            std::memcpy(dest, sorted_quads.data(), bytes);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+    }
+
+    ring_offset += count;
+    return static_cast<GLint>(first * Quad::LENGTH);
+}
+
+void GraphicsGL::resize_ring(std::size_t count)
+{
+    std::size_t capacity = std::max(ring_capacity, RING_QUADS);
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    // Nothing may still read from the old buffer.
+    for (GLsync& fence : ring_fences) {
+        if (fence) {
+            glClientWaitSync(
+                fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (ring_data) {
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        ring_data = nullptr;
+    }
+
+    // Storage allocated with `glBufferStorage` is immutable, so a new
+    // buffer is needed.
+    glDeleteBuffers(1, &vbo);
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    ring_capacity = capacity;
+    ring_offset = 0;
+    ring_segment = 0;
+
+    auto size = static_cast<GLsizeiptr>(capacity * RING_SEGMENTS
+                                        * sizeof(Quad));
+    if (GLEW_ARB_buffer_storage) {
+        GLbitfield flags
+            = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        void* data = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+        ring_data = static_cast<Quad*>(data);
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
 
-    if (cover_scene) {
-        quads.pop_back();
+    // The vertex array object refers to the buffer it was set up with.
+    set_vertex_format();
+}
+
+void GraphicsGL::reserve_indices(std::size_t count)
+{
+    if (count <= index_capacity) {
+        return;
+    }
+
+    std::size_t capacity = std::max(index_capacity, RING_QUADS);
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    std::vector<GLuint> indices;
+    indices.reserve(capacity * 6);
+    for (GLuint i = 0; i < capacity * Quad::LENGTH; i += Quad::LENGTH) {
+        for (GLuint corner : {0u, 1u, 2u, 0u, 2u, 3u}) {
+            indices.push_back(i + corner);
+        }
     }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)),
+                 indices.data(),
+                 GL_STATIC_DRAW);
+    index_capacity = capacity;
 }
 
 void GraphicsGL::clearscene()
 {
+    free_queued_static();
+    free_queued_composites();
+
     if (!locked) {
         quads.clear();
+        commands.clear();
+        static_draws.clear();
+
+        draw_layer = STAGE;
+        draw_blend = ALPHA;
+        reset_depth();
+    }
+}
+
+void GraphicsGL::reset_depth()
+{
+    depth_columns = static_cast<GLshort>(screen.width() / DEPTH_CELL + 1);
+    depth_rows = static_cast<GLshort>(screen.height() / DEPTH_CELL + 1);
+    for (std::vector<std::uint32_t>& cells : depth_cells) {
+        cells.assign(static_cast<std::size_t>(depth_columns)
+                         * static_cast<std::size_t>(depth_rows),
+                     0);
     }
 }
 
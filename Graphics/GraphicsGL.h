@@ -29,6 +29,13 @@
 #include "WzBitmap.h"
 #include FT_FREETYPE_H
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -43,13 +50,42 @@ class GraphicsGL : public Singleton<GraphicsGL>
 public:
     GraphicsGL() noexcept;
 
+    //! Ways of submitting vertices to OpenGL.
+    enum Backend : std::uint8_t {
+        //! GLSL 1.20 and `GL_QUADS`, with the vertex buffer re-specified
+        //! every frame.
+        LEGACY,
+        //! OpenGL 3.3: a vertex array object, a ring buffer which is mapped
+        //! persistently where supported, and indexed triangles.
+        MODERN
+    };
+
     //! Initialise all resources.
     Error init();
     //! Re-initialise after changing screen modes.
     void reinit();
+    //! Return the backend chosen by `init()`.
+    Backend get_backend() const noexcept;
+
+    //! Counters describing the contents of the texture atlas.
+    struct AtlasStats {
+        //! Bytes of bitmap data currently resident in the atlas pages.
+        std::size_t resident_bytes = 0;
+        //! Bitmaps uploaded for the first time.
+        std::size_t uploads = 0;
+        //! Bitmaps uploaded again after having been evicted.
+        std::size_t reuploads = 0;
+        //! Bitmaps evicted from the atlas.
+        std::size_t evictions = 0;
+        //! Atlas pages currently allocated.
+        std::size_t pages = 0;
+    };
 
-    //! Clear all bitmaps if most of the space is used up.
+    //! Evict the least recently used atlas pages if most of the space is
+    //! used up.
     void clear();
+    //! Return counters for resident bytes, evictions and re-uploads.
+    const AtlasStats& get_atlas_stats() const noexcept;
 
     //! Add a bitmap to the available resources.
     void add_bitmap(const WzBitmap& bmp);
@@ -59,7 +95,47 @@ public:
               const Color& color,
               float angle);
 
-    //! Create a layout for the text with the parameters specified.
+    //! Identifies quads retained in video memory, see `begin_static()`.
+    using StaticId = std::uint32_t;
+    static constexpr const StaticId NULL_STATIC = 0;
+
+    //! Record the quads of the following `draw` calls into a static batch
+    //! instead of the scene, until `end_static()` is called.
+    void begin_static();
+    //! Upload the recorded quads and return the id of the new batch.
+    StaticId end_static();
+    //! Draw the parts of a static batch which are on screen after moving
+    //! it by `offset`.
+    void draw_static(StaticId id, Point<std::int16_t> offset);
+    //! Release a static batch. May be called from any thread.
+    void free_static(StaticId id);
+
+    //! Identifies images composed of several bitmaps, see
+    //! `begin_composite()`.
+    using CompositeId = std::uint32_t;
+    static constexpr const CompositeId NULL_COMPOSITE = 0;
+
+    //! Record the bitmaps of the following `draw` calls into a composite
+    //! image instead of the scene, until `end_composite()` is called.
+    //! Return `false` if no image can be recorded right now, because a
+    //! static batch or another image is being recorded or the blend mode
+    //! is not `ALPHA`.
+    bool begin_composite();
+    //! Reserve space for the recorded bitmaps and return the id of the new
+    //! image, or `NULL_COMPOSITE` if there is no space left. The image is
+    //! rendered at the start of the next `flush()`.
+    CompositeId end_composite();
+    //! Draw a composite image as if its bitmaps were drawn with the given
+    //! arguments. Return `false` if it can not be drawn, either because it
+    //! was dropped to make room for others or for the same reasons as
+    //! `begin_composite()`.
+    bool draw_composite(CompositeId id, const DrawArgument& args);
+    //! Release a composite image. May be called from any thread.
+    void free_composite(CompositeId id);
+
+    //! Create a layout for the text with the parameters specified. The
+    //! layout shares its contents with the layout cache, so returning it is
+    //! cheap.
     Text::Layout create_layout(const utf8_string& text,
                                Text::Font font,
                                Text::Alignment alignment,
@@ -85,6 +161,34 @@ public:
     //! Fill the screen with the specified color.
     void draw_screen_fill(float r, float g, float b, float a);
 
+    //! Parts of a frame, drawn in this order.
+    enum DrawLayer : std::uint8_t { STAGE, UI, OVERLAY, NUM_LAYERS };
+
+    //! How quads are combined with what is behind them. `PREMULTIPLIED` is
+    //! used for composite images, whose colors are already multiplied by
+    //! their alpha.
+    enum Blend : std::uint8_t { ALPHA, ADDITIVE, PREMULTIPLIED };
+
+    //! Put the quads of the following draw calls on the specified layer.
+    void set_layer(DrawLayer layer);
+    //! Draw the quads of the following draw calls with the specified blend
+    //! mode.
+    void set_blend(Blend blend);
+
+    //! Counters describing the last frame drawn.
+    struct FrameStats {
+        //! Quads drawn, including those of static batches.
+        std::size_t quads = 0;
+        std::size_t draw_calls = 0;
+        std::size_t texture_binds = 0;
+        std::size_t blend_changes = 0;
+        //! Composite images rendered before the frame.
+        std::size_t composites = 0;
+    };
+
+    //! Return counters for the last frame drawn.
+    const FrameStats& get_frame_stats() const noexcept;
+
     //! Lock the current scene.
     void lock();
     //! Unlock the scene.
@@ -92,7 +196,8 @@ public:
 
     //! Draw the buffer contents with the specified scene opacity.
     void flush(float opacity);
-    //! Clear the buffer contents.
+    //! Clear the buffer contents, and release static batches and composite
+    //! images freed since the last frame.
     void clearscene();
     //! Set the screen rectangle.
     static void set_screen(Rectangle<std::int16_t>&& new_screen) noexcept;
@@ -106,6 +211,8 @@ private:
     void clear_internal();
     bool
     addfont(const char* name, Text::Font id, FT_UInt width, FT_UInt height);
+    //! Compile and link the shader program, and look up its variables.
+    Error create_program(const char* vs_source, const char* fs_source);
 
     struct Offset {
         GLshort l;
@@ -123,8 +230,78 @@ private:
         }
     };
 
+    struct AtlasEntry;
+
     //! Add a bitmap to the available resources.
-    const Offset& get_offset(const WzBitmap& bmp);
+    const AtlasEntry& get_entry(const WzBitmap& bmp);
+    //! Create a new atlas page and return its index.
+    std::uint8_t add_page();
+    //! Bind the texture of an atlas page, if it is not bound already.
+    void bind_page(std::uint8_t page);
+    struct Quad;
+
+    //! Mark an atlas page as drawn from during this frame.
+    void use_page(std::uint8_t page);
+    //! Add a quad to the scene which samples from the specified atlas page.
+    void add_quad(const Quad& quad, std::uint8_t page);
+    //! Return the depth at which a quad covering the specified area is
+    //! drawn, and mark the area as covered at that depth.
+    std::uint32_t claim_depth(GLshort l, GLshort r, GLshort t, GLshort b);
+    //! Mark the whole screen as empty.
+    void reset_depth();
+    //! Sort the draw commands and merge them into batches.
+    void build_batches();
+    //! Change the blend mode used for drawing.
+    void apply_blend(Blend mode);
+    //! Draw quads from the bound vertex buffer, starting at the vertex
+    //! `base`.
+    void draw_quads(GLint base, std::size_t first, std::size_t count);
+    //! Copy the sorted quads into the ring buffer and return the vertex they
+    //! start at.
+    GLint upload_quads();
+    //! Grow the ring buffer so that every segment holds `count` quads.
+    void resize_ring(std::size_t count);
+    //! Grow the index buffer so that it covers `count` quads.
+    void reserve_indices(std::size_t count);
+    //! Remove every bitmap stored in an atlas page.
+    void evict_page(std::uint8_t page);
+    //! Return the first frame whose quads may still be drawn. Pages used
+    //! since then must not be evicted.
+    std::uint64_t live_frame() const noexcept;
+    //! Return the least recently used page which was last drawn from before
+    //! the specified frame, or `NULL_PAGE` if there is none.
+    std::uint8_t find_cold_page(std::uint64_t before) const noexcept;
+    //! Return the fraction of the total atlas capacity in use.
+    float atlas_usage() const noexcept;
+    //! Point the vertex attributes at the currently bound buffer.
+    void set_vertex_format();
+
+    struct StaticBuffer;
+
+    //! Look up the bitmaps of a static batch and upload its vertices.
+    //! Return `false` if its bitmaps do not all fit into the atlas.
+    bool upload_static(StaticBuffer& batch);
+    //! Mark the quads of a static batch which overlap the visible chunks in
+    //! `static_shown`.
+    void find_shown_static(const StaticBuffer& batch,
+                           const Rectangle<std::int16_t>& visible);
+    //! Draw the quads of a static batch which does not fit into the atlas
+    //! one by one.
+    void draw_static_immediate(const StaticBuffer& batch,
+                               const Rectangle<std::int16_t>& visible,
+                               Point<std::int16_t> offset);
+    //! Draw a static batch recorded by `draw_static`.
+    void draw_static_runs(StaticBuffer& batch, Point<std::int16_t> offset);
+    //! Release static batches freed by other threads.
+    void free_queued_static();
+
+    //! Render the composite images created since the last frame, and
+    //! return their number.
+    std::size_t render_composites();
+    //! Drop every composite image and make their space available again.
+    void reset_composites();
+    //! Release composite images freed by other threads.
+    void free_queued_composites();
 
     struct Leftover {
         GLshort l;
@@ -152,6 +329,68 @@ private:
         }
     };
 
+    //! A single texture of the atlas, with its own space allocator.
+    class AtlasPage
+    {
+    public:
+        AtlasPage();
+
+        //! Forget all allocations, keeping the first `reserved` rows free.
+        void reset(GLshort reserved);
+        //! Find space for a bitmap of the given dimensions. Return `false`
+        //! if the page has no room left.
+        bool allocate(GLshort w, GLshort h, GLshort& x, GLshort& y);
+        //! Return the fraction of this page in use.
+        float usage() const noexcept;
+
+        GLuint texture;
+        //! Frame during which a quad was last drawn from this page.
+        std::uint64_t last_used;
+        //! Number of times the page has been evicted.
+        std::uint64_t generation;
+        //! Set while a static batch is built from this page, so that it is
+        //! not evicted for bitmaps of the same batch.
+        bool pinned;
+        std::size_t resident_bytes;
+        std::vector<std::size_t> bitmaps;
+
+    private:
+        QuadTree<std::size_t, Leftover> leftovers;
+        std::size_t rlid;
+        std::size_t wasted;
+        Point<GLshort> border;
+        Range<GLshort> y_range;
+    };
+
+    struct AtlasEntry {
+        Offset offset;
+        std::uint8_t page = NULL_PAGE;
+        bool resident = false;
+    };
+
+    //! A quad or static batch to draw, with the key it is sorted by.
+    //!
+    //! From the most to the least significant bits, the key holds the
+    //! layer, the depth, the blend mode and the atlas page. The depth of a
+    //! command is one more than that of the commands before it which it
+    //! may overlap, so that sorting never swaps overlapping quads.
+    struct DrawCommand {
+        std::uint64_t key;
+        //! Index into the quads of the scene, or into `static_draws` if
+        //! `STATIC_COMMAND` is set.
+        std::uint32_t index;
+    };
+
+    //! Commands drawn with a single call.
+    struct DrawBatch {
+        std::uint8_t page;
+        Blend blend;
+        //! First quad in `sorted_quads`, or the index into `static_draws`.
+        std::size_t first;
+        //! Number of quads, or zero for a static batch.
+        std::size_t count;
+    };
+
     struct Quad {
         struct Vertex {
             GLshort x;
@@ -159,12 +398,39 @@ private:
             GLshort s;
             GLshort t;
 
-            Color c;
+            //! Normalised red, green, blue and alpha bytes.
+            std::array<std::uint8_t, Color::LENGTH> c;
         };
 
         static const std::size_t LENGTH = 4;
         Vertex vertices[LENGTH];
 
+        //! Convert a color to the bytes stored in vertices.
+        static std::array<std::uint8_t, Color::LENGTH>
+        pack(const Color& color) noexcept
+        {
+            std::array<std::uint8_t, Color::LENGTH> c;
+            for (std::size_t i = 0; i < Color::LENGTH; ++i) {
+                float channel = std::clamp(color.data()[i], 0.0f, 1.0f);
+                c[i] = static_cast<std::uint8_t>(channel * 255.0f + 0.5f);
+            }
+
+            return c;
+        }
+
+        Quad(GLshort l,
+             GLshort r,
+             GLshort t,
+             GLshort b,
+             const Offset& o,
+             const std::array<std::uint8_t, Color::LENGTH>& c) noexcept
+        {
+            vertices[0] = {l, t, o.l, o.t, c};
+            vertices[1] = {l, b, o.l, o.b, c};
+            vertices[2] = {r, b, o.r, o.b, c};
+            vertices[3] = {r, t, o.r, o.t, c};
+        }
+
         Quad(GLshort l,
              GLshort r,
              GLshort t,
@@ -172,11 +438,8 @@ private:
              const Offset& o,
              const Color& color,
              GLfloat rot)
+            : Quad{l, r, t, b, o, pack(color)}
         {
-            vertices[0] = {l, t, o.l, o.t, color};
-            vertices[1] = {l, b, o.l, o.b, color};
-            vertices[2] = {r, b, o.r, o.b, color};
-            vertices[3] = {r, t, o.r, o.t, color};
 
             if (rot != 0.0f) {
                 float cos = std::cos(rot);
@@ -196,6 +459,69 @@ private:
         }
     };
 
+    //! A bitmap drawn into a static batch.
+    struct StaticQuad {
+        WzBitmap bitmap;
+        Rectangle<std::int16_t> rect;
+        Color color;
+        float angle;
+    };
+
+    //! Quads of a static batch which are drawn with one call.
+    struct StaticRun {
+        std::uint8_t page;
+        std::size_t first;
+        std::size_t count;
+    };
+
+    //! Quads kept in a vertex buffer, and an index of the square chunks of
+    //! the map they cover.
+    struct StaticBuffer {
+        GLuint vbo = 0;
+        std::vector<StaticQuad> sources;
+        //! Atlas page of each quad.
+        std::vector<std::uint8_t> quad_pages;
+        //! Atlas pages used by any quad.
+        std::vector<std::uint8_t> used_pages;
+        //! Generation of every atlas page when the vertices were uploaded.
+        std::vector<std::uint64_t> generations;
+
+        Point<std::int16_t> origin;
+        std::int16_t columns = 0;
+        std::int16_t rows = 0;
+        //! Indices of the quads overlapping each chunk, in drawing order.
+        std::vector<std::vector<std::uint32_t>> chunks;
+
+        //! The range of visible chunks for which `runs` were built.
+        Rectangle<std::int16_t> visible;
+        std::vector<StaticRun> runs;
+
+        //! Frame during which the vertices were last uploaded.
+        std::uint64_t uploaded = 0;
+        //! Set when the batch does not fit into the atlas, or keeps being
+        //! evicted by other bitmaps. Its visible quads are then drawn one by
+        //! one instead, until it is uploaded again at `retry`.
+        bool immediate = false;
+        //! Frame from which an immediate batch is uploaded again.
+        std::uint64_t retry = 0;
+    };
+
+    //! A static batch drawn as part of the scene.
+    struct StaticDraw {
+        StaticId id;
+        Point<std::int16_t> offset;
+    };
+
+    //! An image in the composite page.
+    struct Composite {
+        Offset offset;
+        //! Point the bitmaps were drawn at, relative to the top left corner.
+        Point<std::int16_t> origin;
+        Point<std::int16_t> dimensions;
+        //! Bitmaps to render, released once the image has been rendered.
+        std::vector<StaticQuad> sources;
+    };
+
     struct Font {
         struct Char {
             GLshort ax;
@@ -257,13 +583,29 @@ private:
                       GLshort bt,
                       Offset offset) noexcept
         {
-            chars.try_emplace(c, ax, ay, bw, bh, bl, bt, offset);
+            if (!find_char(c)) {
+                insert_char(c, ax, ay, bw, bh, bl, bt, offset);
+            }
+        }
+
+        nullable_ptr<Char> find_char(char32_t c) const noexcept
+        {
+            if (c < BMP_SIZE) {
+                const auto& block = bmp[c / BMP_BLOCK];
+                return block ? (*block)[c % BMP_BLOCK] : nullptr;
+            }
+
+            if (auto iter = astral.find(c); iter != astral.end()) {
+                return iter->second;
+            }
+
+            return {};
         }
 
         nullable_ptr<Char> get_or_insert_char(char32_t c) noexcept
         {
-            if (auto iter = chars.find(c); iter != chars.end()) {
-                return &iter->second;
+            if (auto found = find_char(c)) {
+                return found;
             }
 
             if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
@@ -281,6 +623,9 @@ private:
 
             auto& ggl = GraphicsGL::get();
 
+            // Glyphs always live in the first page.
+            ggl.bind_page(0);
+
             if (ggl.font_border.x() + w > ATLASW) {
                 ggl.font_border.set_x(0);
                 ggl.font_border.shift_y(ggl.font_y_max);
@@ -304,15 +649,52 @@ private:
                             g->bitmap.buffer);
 
             Offset offset{ggl.font_border.x(), ggl.font_border.y(), w, h};
-            auto [iter, _] = chars.try_emplace(c, ax, ay, w, h, l, t, offset);
+            Char* inserted = insert_char(c, ax, ay, w, h, l, t, offset);
 
             ggl.font_border.shift_x(w);
 
-            return &iter->second;
+            return inserted;
         }
 
     private:
-        std::unordered_map<char32_t, Char> chars;
+        static constexpr const char32_t BMP_SIZE = 0x10000;
+        static constexpr const char32_t BMP_BLOCK = 0x100;
+
+        using Block = std::array<Char*, BMP_BLOCK>;
+
+        Char* insert_char(char32_t c,
+                          GLshort ax,
+                          GLshort ay,
+                          GLshort bw,
+                          GLshort bh,
+                          GLshort bl,
+                          GLshort bt,
+                          Offset offset)
+        {
+            Char* inserted
+                = &glyphs.emplace_back(ax, ay, bw, bh, bl, bt, offset);
+
+            if (c < BMP_SIZE) {
+                auto& block = bmp[c / BMP_BLOCK];
+                if (!block) {
+                    block = std::make_unique<Block>();
+                }
+                (*block)[c % BMP_BLOCK] = inserted;
+            } else {
+                astral.emplace(c, inserted);
+            }
+
+            return inserted;
+        }
+
+        //! Glyphs in insertion order. A deque keeps them in place, so that
+        //! the tables below can point into it.
+        std::deque<Char> glyphs;
+        //! Glyphs of the Basic Multilingual Plane, indexed directly by code
+        //! point. Blocks of 256 code points are allocated on first use.
+        std::array<std::unique_ptr<Block>, BMP_SIZE / BMP_BLOCK> bmp;
+        //! Glyphs outside of the Basic Multilingual Plane.
+        std::unordered_map<char32_t, Char*> astral;
     };
 
     class LayoutBuilder
@@ -327,7 +709,9 @@ private:
                                    utf8_string::size_type prev,
                                    utf8_string::size_type first,
                                    utf8_string::size_type last);
-        Text::Layout finish(std::size_t first, std::size_t last);
+        Text::Layout finish(const utf8_string& text,
+                            std::size_t first,
+                            std::size_t last);
 
     private:
         void add_word(std::size_t first,
@@ -335,6 +719,7 @@ private:
                       Text::Font font,
                       Text::Color color);
         void add_line();
+        void add_glyphs(const utf8_string& text, Text::Layout::Line& line);
 
         Font& font;
 
@@ -354,17 +739,105 @@ private:
         std::int16_t endy;
     };
 
+    //! Identifies the layouts in the layout cache. Texts with the same
+    //! hash are told apart by comparing the text itself.
+    struct LayoutKey {
+        std::size_t text_hash;
+        Text::Font font;
+        Text::Alignment alignment;
+        std::int16_t max_width;
+        bool formatted;
+
+        bool operator==(const LayoutKey& other) const noexcept
+        {
+            return text_hash == other.text_hash && font == other.font
+                   && alignment == other.alignment
+                   && max_width == other.max_width
+                   && formatted == other.formatted;
+        }
+    };
+
+    struct LayoutKeyHash {
+        std::size_t operator()(const LayoutKey& key) const noexcept
+        {
+            std::size_t hash = key.text_hash;
+            hash = hash * 31 + static_cast<std::size_t>(key.font);
+            hash = hash * 31 + static_cast<std::size_t>(key.alignment);
+            hash = hash * 31 + static_cast<std::uint16_t>(key.max_width);
+            return hash * 2 + key.formatted;
+        }
+    };
+
+    struct CachedLayout {
+        utf8_string text;
+        Text::Layout layout;
+        //! Frame in which the layout was last requested.
+        std::uint64_t last_used;
+    };
+
     static Rectangle<std::int16_t> screen;
 
-    static constexpr const GLshort ATLASW = 8192;
-    static constexpr const GLshort ATLASH = 8192;
+    //! Size of an atlas page. Bitmaps wider than 4096 or taller than 4095
+    //! pixels do not fit into an empty page, and are not drawn.
+    static constexpr const GLshort ATLASW = 4096;
+    static constexpr const GLshort ATLASH = 4096;
     static constexpr const GLshort MINLOSIZE = 32;
+    static constexpr const std::uint8_t MAX_PAGES = 4;
+    static constexpr const std::uint8_t NULL_PAGE = 0xFF;
+    //! Index under which quads sample from the composite page.
+    static constexpr const std::uint8_t COMPOSITE_PAGE = MAX_PAGES;
+    //! `clear()` trims the atlas down to this fraction of its capacity.
+    static constexpr const float TRIM_USAGE = 0.5f;
+    //! Width and height of the chunks static batches are culled by.
+    static constexpr const std::int16_t STATIC_CHUNK = 512;
+    //! Frames an immediate static batch is drawn for before it is uploaded
+    //! again.
+    static constexpr const std::uint64_t STATIC_RETRY_DELAY = 300;
+    //! Frames the ring buffer holds, so that the CPU can write one frame
+    //! while the GPU still reads the previous ones.
+    static constexpr const std::size_t RING_SEGMENTS = 3;
+    //! Initial number of quads per ring buffer segment.
+    static constexpr const std::size_t RING_QUADS = 16'384;
+    //! Marks draw commands which refer to a static batch.
+    static constexpr const std::uint32_t STATIC_COMMAND = 0x8000'0000;
+    //! Size of the screen cells in which the depth of quads is tracked.
+    static constexpr const GLshort DEPTH_CELL = 64;
+    //! Frames between two passes which drop layouts that were not requested
+    //! for `LAYOUT_LIFETIME` frames.
+    static constexpr const std::uint64_t LAYOUT_PRUNE_INTERVAL = 60;
+    static constexpr const std::uint64_t LAYOUT_LIFETIME = 600;
 
     bool locked;
+    //! Frame during which the scene was locked.
+    std::uint64_t locked_frame;
+    Backend backend;
 
     std::vector<Quad> quads;
+    std::vector<DrawCommand> commands;
+    std::vector<Quad> sorted_quads;
+    std::vector<DrawBatch> batches;
+    DrawLayer draw_layer;
+    Blend draw_blend;
+    Blend bound_blend;
+    //! Highest depth drawn in each screen cell, per layer.
+    std::vector<std::uint32_t> depth_cells[NUM_LAYERS];
+    GLshort depth_columns;
+    GLshort depth_rows;
+    FrameStats frame_stats;
     GLuint vbo;
-    GLuint atlas;
+
+    GLuint vao;
+    GLuint ibo;
+    std::size_t index_capacity;
+    //! Persistently mapped contents of the ring buffer, or `nullptr` if
+    //! buffer storage is not supported and the buffer is orphaned instead.
+    Quad* ring_data;
+    //! Quads in one segment of the ring buffer.
+    std::size_t ring_capacity;
+    //! Quad at which the next frame is written, when orphaning.
+    std::size_t ring_offset;
+    std::size_t ring_segment;
+    GLsync ring_fences[RING_SEGMENTS];
 
     GLint program;
     GLint attribute_coord;
@@ -374,15 +847,46 @@ private:
     GLint uniform_screen_size;
     GLint uniform_y_offset;
     GLint uniform_font_region;
+    GLint uniform_translation;
 
-    std::unordered_map<std::size_t, Offset> offsets;
+    std::unordered_map<std::size_t, AtlasEntry> offsets;
     Offset null_offset;
-
-    QuadTree<std::size_t, Leftover> leftovers;
-    std::size_t rlid;
-    std::size_t wasted;
-    Point<GLshort> border;
-    Range<GLshort> y_range;
+    AtlasEntry null_entry;
+
+    std::vector<AtlasPage> pages;
+    std::uint8_t bound_page;
+    //! Set when a bitmap could not be placed because no page could be
+    //! evicted to make room for it.
+    bool atlas_full;
+    std::uint64_t frame;
+    AtlasStats atlas_stats;
+
+    std::mutex queue_mutex;
+
+    std::unordered_map<StaticId, StaticBuffer> static_batches;
+    std::vector<StaticDraw> static_draws;
+    //! Scratch buffer of `find_shown_static`.
+    std::vector<bool> static_shown;
+    std::vector<StaticQuad> recording;
+    bool recording_static;
+    StaticId next_static;
+    std::vector<StaticId> freed_static;
+
+    //! Texture composite images are rendered into. It is kept apart from
+    //! the atlas pages, which are sampled while rendering.
+    AtlasPage composite_page;
+    GLuint composite_fbo;
+    GLuint composite_vbo;
+    std::unordered_map<CompositeId, Composite> composites;
+    std::vector<CompositeId> pending_composites;
+    bool recording_composite;
+    //! Set when the composite page ran out of space. It is emptied after
+    //! the current frame, as quads drawn so far may still sample from it.
+    bool composites_full;
+    CompositeId next_composite;
+    std::vector<CompositeId> freed_composites;
+
+    std::unordered_map<LayoutKey, CachedLayout, LayoutKeyHash> layouts;
 
     FT_Library ft_library;
     Font fonts[Text::NUM_FONTS];
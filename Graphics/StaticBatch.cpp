@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "StaticBatch.h"
+
+namespace jrc
+{
+StaticBatch::StaticBatch() noexcept : id{GraphicsGL::NULL_STATIC}
+{
+}
+
+StaticBatch::~StaticBatch()
+{
+    GraphicsGL::get().free_static(id);
+}
+
+StaticBatch::StaticBatch(StaticBatch&& other) noexcept : id{other.id}
+{
+    other.id = GraphicsGL::NULL_STATIC;
+}
+
+StaticBatch& StaticBatch::operator=(StaticBatch&& other) noexcept
+{
+    std::swap(id, other.id);
+    return *this;
+}
+
+bool StaticBatch::is_recorded() const noexcept
+{
+    return id != GraphicsGL::NULL_STATIC;
+}
+
+void StaticBatch::draw(Point<std::int16_t> offset) const
+{
+    GraphicsGL::get().draw_static(id, offset);
+}
+} // namespace jrc
@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../Template/Point.h"
+#include "GraphicsGL.h"
+
+#include <utility>
+
+namespace jrc
+{
+//! Geometry which never changes, eg. the tiles of a map layer. The quads are
+//! recorded once and kept in video memory, and only the parts on screen are
+//! drawn.
+class StaticBatch
+{
+public:
+    StaticBatch() noexcept;
+    ~StaticBatch();
+
+    StaticBatch(StaticBatch&& other) noexcept;
+    StaticBatch& operator=(StaticBatch&& other) noexcept;
+
+    StaticBatch(const StaticBatch&) = delete;
+    StaticBatch& operator=(const StaticBatch&) = delete;
+
+    //! Record the quads drawn by the specified function, replacing the
+    //! previous contents.
+    template<typename DrawFn>
+    void record(DrawFn&& draw_fn)
+    {
+        auto& graphics = GraphicsGL::get();
+        graphics.free_static(id);
+        graphics.begin_static();
+        std::forward<DrawFn>(draw_fn)();
+        id = graphics.end_static();
+    }
+
+    //! Check whether the batch has been recorded.
+    bool is_recorded() const noexcept;
+    //! Draw the batch moved by the specified offset.
+    void draw(Point<std::int16_t> offset) const;
+
+private:
+    GraphicsGL::StaticId id;
+};
+} // namespace jrc
@@ -135,53 +135,58 @@ const utf8_string& Text::get_text() const noexcept
     return text;
 }
 
-Text::Layout::Layout(const std::vector<Line>& l,
-                     const std::vector<std::int16_t>& a,
+Text::Layout::Layout(std::vector<Line> l,
+                     std::vector<std::int16_t> a,
                      std::int16_t w,
                      std::int16_t h,
                      std::int16_t ex,
                      std::int16_t ey)
-    : lines{l}, advances{a}, dimensions{w, h}, endoffset{ex, ey}
+    : contents{std::make_shared<const Contents>(
+        Contents{std::move(l), std::move(a), {w, h}, {ex, ey}})}
 {
 }
 
-Text::Layout::Layout() : Layout{{}, {}, 0, 0, 0, 0}
+Text::Layout::Layout()
 {
+    // Empty layouts are common, so they all share the same contents.
+    static const auto empty = std::make_shared<const Contents>();
+    contents = empty;
 }
 
 std::int16_t Text::Layout::width() const
 {
-    return dimensions.x();
+    return contents->dimensions.x();
 }
 
 std::int16_t Text::Layout::height() const
 {
-    return dimensions.y();
+    return contents->dimensions.y();
 }
 
 std::int16_t Text::Layout::advance(std::size_t index) const
 {
+    const std::vector<std::int16_t>& advances = contents->advances;
     return static_cast<std::int16_t>(index < advances.size() ? advances[index]
                                                              : 0);
 }
 
 Point<std::int16_t> Text::Layout::get_dimensions() const
 {
-    return dimensions;
+    return contents->dimensions;
 }
 
 Point<std::int16_t> Text::Layout::get_endoffset() const
 {
-    return endoffset;
+    return contents->endoffset;
 }
 
 Text::Layout::iterator Text::Layout::begin() const
 {
-    return lines.begin();
+    return contents->lines.begin();
 }
 
 Text::Layout::iterator Text::Layout::end() const
 {
-    return lines.end();
+    return contents->lines.end();
 }
 } // namespace jrc
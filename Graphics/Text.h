@@ -21,6 +21,7 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <vector>
 using namespace tiny_utf8;
 namespace jrc
@@ -68,9 +69,24 @@ public:
             }
         };
 
+        //! A glyph of a line, positioned relative to the origin of the
+        //! text.
+        struct Glyph {
+            Rectangle<std::int16_t> bounds;
+            //! Region of the glyph in the font atlas.
+            Rectangle<std::int16_t> source;
+            //! Color of the word, or `NUM_COLORS` for the color of the text.
+            Color color;
+        };
+
         struct Line {
             std::vector<Word> words;
             Point<std::int16_t> position;
+            //! The glyphs of the line, laid out once so that drawing the
+            //! line only has to translate them.
+            std::vector<Glyph> glyphs;
+            //! Rectangle covering all glyphs.
+            Rectangle<std::int16_t> bounds;
 
             Line(std::vector<Word>&& words_,
                  Point<std::int16_t> position_) noexcept
@@ -85,8 +101,8 @@ public:
             }
         };
 
-        Layout(const std::vector<Line>& lines,
-               const std::vector<std::int16_t>& advances,
+        Layout(std::vector<Line> lines,
+               std::vector<std::int16_t> advances,
                std::int16_t width,
                std::int16_t height,
                std::int16_t endx,
@@ -104,10 +120,15 @@ public:
         iterator end() const;
 
     private:
-        std::vector<Line> lines;
-        std::vector<std::int16_t> advances;
-        Point<std::int16_t> dimensions;
-        Point<std::int16_t> endoffset;
+        struct Contents {
+            std::vector<Line> lines;
+            std::vector<std::int16_t> advances;
+            Point<std::int16_t> dimensions;
+            Point<std::int16_t> endoffset;
+        };
+
+        //! Shared by all copies, so that copying a cached layout is cheap.
+        std::shared_ptr<const Contents> contents;
     };
 
     Text(Font font,
@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "ProfilerOverlay.h"
+
+#include "../Console.h"
+#include "../Constants.h"
+#include "../Graphics/GraphicsGL.h"
+#include "../Net/Session.h"
+#include "../Util/Profiler.h"
+#include "../Util/Str.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace jrc
+{
+ProfilerOverlay::ProfilerOverlay() noexcept : visible{false}, frames{0}
+{
+}
+
+void ProfilerOverlay::toggle()
+{
+    visible = !visible;
+    frames = 0;
+
+    Profiler::get().set_enabled(visible);
+}
+
+void ProfilerOverlay::export_trace() const
+{
+    if (!Profiler::get().export_trace(TRACE_FILE)) {
+        Console::get().print(__func__,
+                             "Could not write the trace to "
+                             + std::string{TRACE_FILE});
+    }
+}
+
+void ProfilerOverlay::update()
+{
+    if (!visible || frames++ % REFRESH_FRAMES != 0) {
+        return;
+    }
+
+    // Lines are separated with the `\n` escape of formatted text.
+    std::string lines = "phase: last / avg / peak (ms)";
+    char line[96];
+    for (const Profiler::Phase& phase : Profiler::get().get_phases()) {
+        std::snprintf(line,
+                      sizeof(line),
+                      "\\n%*s%s: %.2f / %.2f / %.2f",
+                      phase.depth * 2,
+                      "",
+                      phase.name,
+                      phase.last_ms,
+                      phase.average_ms,
+                      phase.peak_ms);
+        lines += line;
+    }
+
+    const PacketSwitch& packet_switch = Session::get().get_packet_switch();
+    std::vector<std::uint16_t> slowest
+        = packet_switch.get_slowest(SLOWEST_OPCODES);
+    if (!slowest.empty()) {
+        lines += "\\nslowest packets: count / avg / max (ms)";
+    }
+    for (std::uint16_t opcode : slowest) {
+        const PacketSwitch::OpcodeStats* stats
+            = packet_switch.get_stats(opcode);
+        std::snprintf(line,
+                      sizeof(line),
+                      "\\n  %s: %zu / %.2f / %.2f",
+                      str::to_hex(opcode).c_str(),
+                      stats->count,
+                      stats->total_time / 1e6 / stats->count,
+                      stats->max_time / 1e6);
+        lines += line;
+    }
+
+    text = utf8_string{lines};
+    layout = GraphicsGL::get().create_layout(
+        text, Text::A11M, Text::LEFT, Constants::VIEW_WIDTH, true);
+}
+
+void ProfilerOverlay::draw() const
+{
+    if (!visible) {
+        return;
+    }
+
+    constexpr std::int16_t x = 4;
+    constexpr std::int16_t y = 14 - Constants::VIEW_Y_OFFSET;
+
+    GraphicsGL& graphics = GraphicsGL::get();
+    graphics.set_layer(GraphicsGL::OVERLAY);
+    graphics.draw_rectangle(x - 2,
+                            y - 2,
+                            layout.width() + 4,
+                            layout.height() + 4,
+                            0.0f,
+                            0.0f,
+                            0.0f,
+                            0.6f);
+    graphics.draw_text(
+        {x, y}, text, layout, Text::A11M, Text::WHITE, Text::NONE);
+}
+} // namespace jrc
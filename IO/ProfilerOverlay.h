@@ -0,0 +1,55 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../Graphics/Text.h"
+#include "../Template/Singleton.h"
+
+#include <cstdint>
+
+namespace jrc
+{
+//! Lists the timings of the profiled frame phases in the top-left corner of
+//! the screen. Showing the overlay turns on recording in the `Profiler`.
+class ProfilerOverlay : public Singleton<ProfilerOverlay>
+{
+public:
+    ProfilerOverlay() noexcept;
+
+    //! Show or hide the overlay.
+    void toggle();
+    //! Write the events recorded so far to `TRACE_FILE`.
+    void export_trace() const;
+
+    //! Refresh the listed timings. Call once per frame, after
+    //! `Profiler::end_frame()`.
+    void update();
+    void draw() const;
+
+private:
+    static constexpr const char* TRACE_FILE = "profile-trace.json";
+    //! Frames between refreshes of the text, to keep it readable.
+    static constexpr std::uint16_t REFRESH_FRAMES = 30;
+    //! Opcodes listed with their handler times.
+    static constexpr std::size_t SLOWEST_OPCODES = 5;
+
+    bool visible;
+    std::uint16_t frames;
+    utf8_string text;
+    Text::Layout layout;
+};
+} // namespace jrc
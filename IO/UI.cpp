@@ -18,6 +18,7 @@
 #include "UI.h"
 
 #include "../Graphics/GraphicsGL.h"
+#include "../Util/Profiler.h"
 #include "UIStateGame.h"
 #include "UIStateLogin.h"
 #include "UITypes/UIChangeChannel.h"
@@ -37,6 +38,10 @@ void UI::init()
 
 void UI::draw(float alpha) const
 {
+    ProfileScope scope{"UI::draw"};
+
+    GraphicsGL::get().set_layer(GraphicsGL::UI);
+
     state->draw(alpha, cursor.get_position());
 
     scrolling_notice.draw(alpha);
@@ -45,6 +50,8 @@ void UI::draw(float alpha) const
 
 void UI::update()
 {
+    ProfileScope scope{"UI::update"};
+
     state->update();
 
     scrolling_notice.update();
@@ -22,6 +22,8 @@
 #include "../Constants.h"
 #include "../Graphics/GraphicsGL.h"
 #include "../Util/Misc.h"
+#include "../Util/Profiler.h"
+#include "ProfilerOverlay.h"
 #include "UI.h"
 
 #include <string_view>
@@ -33,6 +35,8 @@ Window::Window()
       context{nullptr},
       opacity{1.0f},
       opcstep{0.0f},
+      overlay_key_down{false},
+      trace_key_down{false},
       width{Constants::VIEW_WIDTH},
       height{Constants::VIEW_HEIGHT}
 {
@@ -167,6 +171,21 @@ void Window::update_opc()
 
 void Window::check_events()
 {
+    ProfileScope scope{"Window::check_events"};
+
+    // F10 toggles the profiler overlay, F9 exports the recorded trace.
+    bool overlay_key = glfwGetKey(glwnd, GLFW_KEY_F10) == GLFW_PRESS;
+    if (overlay_key && !overlay_key_down) {
+        ProfilerOverlay::get().toggle();
+    }
+    overlay_key_down = overlay_key;
+
+    bool trace_key = glfwGetKey(glwnd, GLFW_KEY_F9) == GLFW_PRESS;
+    if (trace_key && !trace_key_down) {
+        ProfilerOverlay::get().export_trace();
+    }
+    trace_key_down = trace_key;
+
     std::int32_t tabstate = glfwGetKey(glwnd, GLFW_KEY_F11);
     if (tabstate == GLFW_PRESS) {
         full_screen = !full_screen;
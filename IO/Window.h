@@ -59,6 +59,8 @@ private:
     float opacity;
     float opcstep;
     std::function<void()> fade_procedure;
+    bool overlay_key_down;
+    bool trace_key_down;
 
     std::int16_t width;
     std::int16_t height;
@@ -22,12 +22,15 @@
 #include "Error.h"
 #include "Gameplay/Combat/DamageNumber.h"
 #include "Gameplay/Stage.h"
+#include "IO/ProfilerOverlay.h"
 #include "IO/UI.h"
 #include "IO/Window.h"
 #include "Net/Session.h"
 #include "Timer.h"
+#include "Util/Profiler.h"
 #include "Wz.h"
 
+#include <future>
 #include <iostream>
 #include <locale>
 
@@ -35,19 +38,28 @@ namespace jrc
 {
 Error init()
 {
-    if (Error error = Session::get().init(); error) {
-        return error;
-    }
-
-    WzFile::loadAll("/Users/zhangchenghui/workspace/cpp_space/game/maplestory/Data/");
+    // Reading the game files takes longest. Connecting and creating the
+    // window do not need them, so they happen in the meantime. The loading
+    // is started only once, even if `init()` is retried.
+    static std::shared_future<void> wz_loading
+        = std::async(std::launch::async, [] {
+              WzFile::loadAll("/Users/zhangchenghui/workspace/cpp_space/game/maplestory/Data/");
+          }).share();
     // if (Error error = NxFiles::init(); error) {
     //     return error;
     // }
 
+    if (Error error = Session::get().init(); error) {
+        return error;
+    }
+
     if (Error error = Window::get().init(); error) {
         return error;
     }
 
+    // Rethrows any error raised while reading the game files.
+    wz_loading.get();
+
     if (Configuration::get().audio.sound_effects
         || Configuration::get().audio.music) {
         if (Error error = Sound::init(); error) {
@@ -84,6 +96,7 @@ void draw(float alpha)
     Window::get().begin();
     Stage::get().draw(alpha);
     UI::get().draw(alpha);
+    ProfilerOverlay::get().draw();
     Window::get().end();
 }
 
@@ -115,6 +128,9 @@ void loop()
         float alpha = static_cast<float>(accumulator) / timestep;
         draw(alpha);
 
+        Profiler::get().end_frame();
+        ProfilerOverlay::get().update();
+
         if (samples < 100) {
             period += elapsed;
             ++samples;
@@ -128,6 +144,11 @@ void loop()
     }
 
     Sound::close();
+
+    PacketSwitch& packet_switch = Session::get().get_packet_switch();
+    if (!packet_switch.get_slowest(1).empty()) {
+        packet_switch.dump_stats(std::cout);
+    }
 }
 
 void start()
@@ -19,6 +19,154 @@
 
 namespace jrc
 {
+namespace
+{
+// This key is pre-expanded. Works only for lower versions.
+constexpr const std::uint8_t MAPLE_KEY[256] = {
+    0x13, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0xB4, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x33, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00, 0x71, 0x63, 0x63, 0x00,
+    0x79, 0x63, 0x63, 0x00, 0x7F, 0x63, 0x63, 0x00, 0xCB, 0x63, 0x63, 0x00,
+    0x04, 0xFB, 0xFB, 0x63, 0x0B, 0xFB, 0xFB, 0x63, 0x38, 0xFB, 0xFB, 0x63,
+    0x6A, 0xFB, 0xFB, 0x63, 0x7C, 0x6C, 0x98, 0x02, 0x05, 0x0F, 0xFB, 0x02,
+    0x7A, 0x6C, 0x98, 0x02, 0xB1, 0x0F, 0xFB, 0x02, 0xCC, 0x8D, 0xF4, 0x14,
+    0xC7, 0x76, 0x0F, 0x77, 0xFF, 0x8D, 0xF4, 0x14, 0x95, 0x76, 0x0F, 0x77,
+    0x40, 0x1A, 0x6D, 0x28, 0x45, 0x15, 0x96, 0x2A, 0x3F, 0x79, 0x0E, 0x28,
+    0x8E, 0x76, 0xF5, 0x2A, 0xD5, 0xB5, 0x12, 0xF1, 0x12, 0xC3, 0x1D, 0x86,
+    0xED, 0x4E, 0xE9, 0x92, 0x78, 0x38, 0xE6, 0xE5, 0x4F, 0x94, 0xB4, 0x94,
+    0x0A, 0x81, 0x22, 0xBE, 0x35, 0xF8, 0x2C, 0x96, 0xBB, 0x8E, 0xD9, 0xBC,
+    0x3F, 0xAC, 0x27, 0x94, 0x2D, 0x6F, 0x3A, 0x12, 0xC0, 0x21, 0xD3, 0x80,
+    0xB8, 0x19, 0x35, 0x65, 0x8B, 0x02, 0xF9, 0xF8, 0x81, 0x83, 0xDB, 0x46,
+    0xB4, 0x7B, 0xF7, 0xD0, 0x0F, 0xF5, 0x2E, 0x6C, 0x49, 0x4A, 0x16, 0xC4,
+    0x64, 0x25, 0x2C, 0xD6, 0xA4, 0x04, 0xFF, 0x56, 0x1C, 0x1D, 0xCA, 0x33,
+    0x0F, 0x76, 0x3A, 0x64, 0x8E, 0xF5, 0xE1, 0x22, 0x3A, 0x8E, 0x16, 0xF2,
+    0x35, 0x7B, 0x38, 0x9E, 0xDF, 0x6B, 0x11, 0xCF, 0xBB, 0x4E, 0x3D, 0x19,
+    0x1F, 0x4A, 0xC2, 0x4F, 0x03, 0x57, 0x08, 0x7C, 0x14, 0x46, 0x2A, 0x1F,
+    0x9A, 0xB3, 0xCB, 0x3D, 0xA0, 0x3D, 0xDD, 0xCF, 0x95, 0x46, 0xE5, 0x51,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00};
+
+// Rijndael substitution box.
+constexpr const std::uint8_t SUBBOX[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B,
+    0xFE, 0xD7, 0xAB, 0x76, 0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0,
+    0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0, 0xB7, 0xFD, 0x93, 0x26,
+    0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2,
+    0xEB, 0x27, 0xB2, 0x75, 0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0,
+    0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84, 0x53, 0xD1, 0x00, 0xED,
+    0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F,
+    0x50, 0x3C, 0x9F, 0xA8, 0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5,
+    0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2, 0xCD, 0x0C, 0x13, 0xEC,
+    0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14,
+    0xDE, 0x5E, 0x0B, 0xDB, 0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C,
+    0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79, 0xE7, 0xC8, 0x37, 0x6D,
+    0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F,
+    0x4B, 0xBD, 0x8B, 0x8A, 0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E,
+    0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E, 0xE1, 0xF8, 0x98, 0x11,
+    0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F,
+    0xB0, 0x54, 0xBB, 0x16};
+
+constexpr const std::size_t AES_ROUNDS = 14;
+
+constexpr std::uint8_t rol8(std::uint8_t byte, std::size_t count)
+{
+    count %= 8;
+    return static_cast<std::uint8_t>((byte << count) | (byte >> (8 - count)));
+}
+
+constexpr std::uint8_t ror8(std::uint8_t byte, std::size_t count)
+{
+    count %= 8;
+    return static_cast<std::uint8_t>((byte >> count) | (byte << (8 - count)));
+}
+
+constexpr std::uint32_t rol32(std::uint32_t word, std::size_t count)
+{
+    return (word << count) | (word >> (32 - count));
+}
+
+//! Lookup tables which merge the AES round steps, and the per-byte steps of
+//! the maple custom encryption.
+struct CipherTables {
+    //! Subbytes and mixcolumns for each row of a column, as little-endian
+    //! words.
+    std::uint32_t te[4][256];
+    //! Round keys as little-endian columns.
+    std::uint32_t round_keys[AES_ROUNDS + 1][4];
+
+    // Encryption, first pass: the final step of a byte for each rotation.
+    std::uint8_t enc_rotate[8][256];
+    // Encryption, first pass: rollleft by 3.
+    std::uint8_t enc_rol3[256];
+    // Encryption, second pass: rollleft by 4.
+    std::uint8_t enc_rol4[256];
+    // Encryption, second pass: xor with 0x13 and rollright by 3.
+    std::uint8_t enc_ror3[256];
+    // Decryption, first pass: rollleft by 3 and xor with 0x13.
+    std::uint8_t dec_rol3[256];
+    // Decryption, first pass: rollright by 4.
+    std::uint8_t dec_ror4[256];
+    // Decryption, second pass: undo the final step for each rotation.
+    std::uint8_t dec_rotate[8][256];
+    // Decryption, second pass: rollright by 3.
+    std::uint8_t dec_ror3[256];
+};
+
+constexpr CipherTables make_cipher_tables()
+{
+    CipherTables tables{};
+
+    for (std::size_t i = 0; i < 256; ++i) {
+        std::uint8_t sub = SUBBOX[i];
+        auto sub2 = static_cast<std::uint8_t>(
+            (sub << 1) ^ ((sub & 0x80) ? 0x1B : 0x00));
+        auto sub3 = static_cast<std::uint8_t>(sub2 ^ sub);
+
+        std::uint32_t word = sub2 | (sub << 8) | (sub << 16)
+                             | (static_cast<std::uint32_t>(sub3) << 24);
+        tables.te[0][i] = word;
+        tables.te[1][i] = rol32(word, 8);
+        tables.te[2][i] = rol32(word, 16);
+        tables.te[3][i] = rol32(word, 24);
+
+        auto byte = static_cast<std::uint8_t>(i);
+        tables.enc_rol3[i] = rol8(byte, 3);
+        tables.enc_rol4[i] = rol8(byte, 4);
+        tables.enc_ror3[i] = ror8(byte ^ 0x13, 3);
+        tables.dec_rol3[i] = rol8(byte, 3) ^ 0x13;
+        tables.dec_ror4[i] = ror8(byte, 4);
+        tables.dec_ror3[i] = ror8(byte, 3);
+
+        for (std::size_t r = 0; r < 8; ++r) {
+            tables.enc_rotate[r][i]
+                = static_cast<std::uint8_t>(~ror8(byte, r) + 0x48);
+            tables.dec_rotate[r][i]
+                = rol8(static_cast<std::uint8_t>(~(byte - 0x48)), r);
+        }
+    }
+
+    for (std::size_t round = 0; round <= AES_ROUNDS; ++round) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            const std::uint8_t* key = MAPLE_KEY + 16 * round + 4 * c;
+            tables.round_keys[round][c]
+                = key[0] | (key[1] << 8) | (key[2] << 16)
+                  | (static_cast<std::uint32_t>(key[3]) << 24);
+        }
+    }
+
+    return tables;
+}
+
+constexpr const CipherTables CIPHER_TABLES = make_cipher_tables();
+} // namespace
+
+std::atomic<Cryptography::Backend> Cryptography::backend = TABLE;
+
 Cryptography::Cryptography(const std::int8_t* handshake)
 {
 #ifdef JOURNEY_USE_CRYPTO
@@ -39,19 +187,39 @@ Cryptography::~Cryptography() = default;
 void Cryptography::encrypt(std::int8_t* bytes, std::size_t length) noexcept
 {
 #ifdef JOURNEY_USE_CRYPTO
-    mapleencrypt(bytes, length);
-    aesofb(bytes, length, sendiv);
+    if (backend == TABLE) {
+        mapleencrypt_table(bytes, length);
+        aesofb_table(bytes, length, sendiv);
+    } else {
+        mapleencrypt(bytes, length);
+        aesofb(bytes, length, sendiv);
+    }
 #endif
 }
 
 void Cryptography::decrypt(std::int8_t* bytes, std::size_t length)
 {
 #ifdef JOURNEY_USE_CRYPTO
-    aesofb(bytes, length, recviv);
-    mapledecrypt(bytes, length);
+    if (backend == TABLE) {
+        aesofb_table(bytes, length, recviv);
+        mapledecrypt_table(bytes, length);
+    } else {
+        aesofb(bytes, length, recviv);
+        mapledecrypt(bytes, length);
+    }
 #endif
 }
 
+void Cryptography::set_backend(Backend b) noexcept
+{
+    backend = b;
+}
+
+Cryptography::Backend Cryptography::get_backend() noexcept
+{
+    return backend;
+}
+
 void Cryptography::create_header(std::int8_t* buffer, std::size_t length) const
     noexcept
 {
@@ -279,66 +447,16 @@ void Cryptography::aesencrypt(std::uint8_t* bytes) const
 
 void Cryptography::addroundkey(std::uint8_t* bytes, std::uint8_t round) const
 {
-    // This key is pre-expanded. Works only for lower versions.
-    static const std::uint8_t maplekey[256] = {
-        0x13, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
-        0xB4, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
-        0x33, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00, 0x71, 0x63, 0x63, 0x00,
-        0x79, 0x63, 0x63, 0x00, 0x7F, 0x63, 0x63, 0x00, 0xCB, 0x63, 0x63, 0x00,
-        0x04, 0xFB, 0xFB, 0x63, 0x0B, 0xFB, 0xFB, 0x63, 0x38, 0xFB, 0xFB, 0x63,
-        0x6A, 0xFB, 0xFB, 0x63, 0x7C, 0x6C, 0x98, 0x02, 0x05, 0x0F, 0xFB, 0x02,
-        0x7A, 0x6C, 0x98, 0x02, 0xB1, 0x0F, 0xFB, 0x02, 0xCC, 0x8D, 0xF4, 0x14,
-        0xC7, 0x76, 0x0F, 0x77, 0xFF, 0x8D, 0xF4, 0x14, 0x95, 0x76, 0x0F, 0x77,
-        0x40, 0x1A, 0x6D, 0x28, 0x45, 0x15, 0x96, 0x2A, 0x3F, 0x79, 0x0E, 0x28,
-        0x8E, 0x76, 0xF5, 0x2A, 0xD5, 0xB5, 0x12, 0xF1, 0x12, 0xC3, 0x1D, 0x86,
-        0xED, 0x4E, 0xE9, 0x92, 0x78, 0x38, 0xE6, 0xE5, 0x4F, 0x94, 0xB4, 0x94,
-        0x0A, 0x81, 0x22, 0xBE, 0x35, 0xF8, 0x2C, 0x96, 0xBB, 0x8E, 0xD9, 0xBC,
-        0x3F, 0xAC, 0x27, 0x94, 0x2D, 0x6F, 0x3A, 0x12, 0xC0, 0x21, 0xD3, 0x80,
-        0xB8, 0x19, 0x35, 0x65, 0x8B, 0x02, 0xF9, 0xF8, 0x81, 0x83, 0xDB, 0x46,
-        0xB4, 0x7B, 0xF7, 0xD0, 0x0F, 0xF5, 0x2E, 0x6C, 0x49, 0x4A, 0x16, 0xC4,
-        0x64, 0x25, 0x2C, 0xD6, 0xA4, 0x04, 0xFF, 0x56, 0x1C, 0x1D, 0xCA, 0x33,
-        0x0F, 0x76, 0x3A, 0x64, 0x8E, 0xF5, 0xE1, 0x22, 0x3A, 0x8E, 0x16, 0xF2,
-        0x35, 0x7B, 0x38, 0x9E, 0xDF, 0x6B, 0x11, 0xCF, 0xBB, 0x4E, 0x3D, 0x19,
-        0x1F, 0x4A, 0xC2, 0x4F, 0x03, 0x57, 0x08, 0x7C, 0x14, 0x46, 0x2A, 0x1F,
-        0x9A, 0xB3, 0xCB, 0x3D, 0xA0, 0x3D, 0xDD, 0xCF, 0x95, 0x46, 0xE5, 0x51,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00};
-
     std::uint8_t offset = round * static_cast<uint8_t>(16u);
     for (std::uint8_t i = 0; i < 16; ++i) {
-        bytes[i] ^= maplekey[i + offset];
+        bytes[i] ^= MAPLE_KEY[i + offset];
     }
 }
 
 void Cryptography::subbytes(std::uint8_t* bytes) const
 {
-    // Rijndael substitution box.
-    static const std::uint8_t subbox[256] = {
-        0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B,
-        0xFE, 0xD7, 0xAB, 0x76, 0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0,
-        0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0, 0xB7, 0xFD, 0x93, 0x26,
-        0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
-        0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2,
-        0xEB, 0x27, 0xB2, 0x75, 0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0,
-        0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84, 0x53, 0xD1, 0x00, 0xED,
-        0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
-        0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F,
-        0x50, 0x3C, 0x9F, 0xA8, 0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5,
-        0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2, 0xCD, 0x0C, 0x13, 0xEC,
-        0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
-        0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14,
-        0xDE, 0x5E, 0x0B, 0xDB, 0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C,
-        0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79, 0xE7, 0xC8, 0x37, 0x6D,
-        0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
-        0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F,
-        0x4B, 0xBD, 0x8B, 0x8A, 0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E,
-        0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E, 0xE1, 0xF8, 0x98, 0x11,
-        0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
-        0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F,
-        0xB0, 0x54, 0xBB, 0x16};
-
     for (std::uint8_t i = 0; i < 16; ++i) {
-        bytes[i] = subbox[bytes[i]];
+        bytes[i] = SUBBOX[bytes[i]];
     }
 }
 
@@ -391,4 +509,153 @@ void Cryptography::mixcolumns(std::uint8_t* bytes) const
         bytes[i + 3] = mul3 ^ cpy2 ^ cpy1 ^ mul0 ^ cpy0;
     }
 }
+
+void Cryptography::mapleencrypt_table(std::int8_t* bytes,
+                                      std::size_t length) const noexcept
+{
+    const CipherTables& t = CIPHER_TABLES;
+    auto* data = reinterpret_cast<std::uint8_t*>(bytes);
+
+    for (std::size_t j = 0; j < 3; ++j) {
+        std::uint8_t remember = 0;
+        auto datalen = static_cast<std::uint8_t>(length & 0xFF);
+
+        for (std::size_t i = 0; i < length; ++i) {
+            std::uint8_t cur = (t.enc_rol3[data[i]] + datalen) ^ remember;
+            remember = cur;
+            data[i] = t.enc_rotate[datalen & 7][cur];
+            --datalen;
+        }
+
+        remember = 0;
+        datalen = static_cast<std::uint8_t>(length & 0xFF);
+
+        for (std::size_t i = length; i--;) {
+            std::uint8_t cur = (t.enc_rol4[data[i]] + datalen) ^ remember;
+            remember = cur;
+            data[i] = t.enc_ror3[cur];
+            --datalen;
+        }
+    }
+}
+
+void Cryptography::mapledecrypt_table(std::int8_t* bytes,
+                                      std::size_t length) const noexcept
+{
+    const CipherTables& t = CIPHER_TABLES;
+    auto* data = reinterpret_cast<std::uint8_t*>(bytes);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::uint8_t remember = 0;
+        auto datalen = static_cast<std::uint8_t>(length & 0xFF);
+
+        for (std::size_t j = length; j--;) {
+            std::uint8_t cur = t.dec_rol3[data[j]];
+            data[j] = t.dec_ror4[static_cast<std::uint8_t>(
+                (cur ^ remember) - datalen)];
+            remember = cur;
+            --datalen;
+        }
+
+        remember = 0;
+        datalen = static_cast<std::uint8_t>(length & 0xFF);
+
+        for (std::size_t j = 0; j < length; ++j) {
+            std::uint8_t cur = t.dec_rotate[datalen & 7][data[j]];
+            data[j] = t.dec_ror3[static_cast<std::uint8_t>(
+                (cur ^ remember) - datalen)];
+            remember = cur;
+            --datalen;
+        }
+    }
+}
+
+void Cryptography::aesofb_table(std::int8_t* bytes,
+                                std::size_t length,
+                                std::uint8_t* iv) const noexcept
+{
+    std::uint32_t ivword = iv[0] | (iv[1] << 8) | (iv[2] << 16)
+                           | (static_cast<std::uint32_t>(iv[3]) << 24);
+
+    std::size_t blocklength = 0x5B0;
+    std::size_t offset = 0;
+
+    while (offset < length) {
+        std::uint32_t state[4] = {ivword, ivword, ivword, ivword};
+
+        std::size_t remaining = length - offset;
+
+        if (remaining > blocklength) {
+            remaining = blocklength;
+        }
+
+        for (std::size_t x = 0; x < remaining; x += 16) {
+            aesencrypt_table(state);
+
+            std::size_t count = remaining - x < 16 ? remaining - x : 16;
+            std::int8_t* block = bytes + offset + x;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                block[i] ^= static_cast<std::int8_t>(state[i / 4]
+                                                     >> (8 * (i % 4)));
+            }
+        }
+
+        offset += blocklength;
+        blocklength = 0x5B4;
+    }
+
+    updateiv(iv);
+}
+
+void Cryptography::aesencrypt_table(std::uint32_t* state) const noexcept
+{
+    const CipherTables& t = CIPHER_TABLES;
+    const auto& te = t.te;
+    const auto& rk = t.round_keys;
+
+    std::uint32_t s0 = state[0] ^ rk[0][0];
+    std::uint32_t s1 = state[1] ^ rk[0][1];
+    std::uint32_t s2 = state[2] ^ rk[0][2];
+    std::uint32_t s3 = state[3] ^ rk[0][3];
+
+    // Each output column takes row r from input column (c + r) % 4, which
+    // is the shiftrows step.
+    for (std::size_t round = 1; round < AES_ROUNDS; ++round) {
+        std::uint32_t t0 = te[0][s0 & 0xFF] ^ te[1][(s1 >> 8) & 0xFF]
+                           ^ te[2][(s2 >> 16) & 0xFF] ^ te[3][s3 >> 24]
+                           ^ rk[round][0];
+        std::uint32_t t1 = te[0][s1 & 0xFF] ^ te[1][(s2 >> 8) & 0xFF]
+                           ^ te[2][(s3 >> 16) & 0xFF] ^ te[3][s0 >> 24]
+                           ^ rk[round][1];
+        std::uint32_t t2 = te[0][s2 & 0xFF] ^ te[1][(s3 >> 8) & 0xFF]
+                           ^ te[2][(s0 >> 16) & 0xFF] ^ te[3][s1 >> 24]
+                           ^ rk[round][2];
+        std::uint32_t t3 = te[0][s3 & 0xFF] ^ te[1][(s0 >> 8) & 0xFF]
+                           ^ te[2][(s1 >> 16) & 0xFF] ^ te[3][s2 >> 24]
+                           ^ rk[round][3];
+
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // The last round has no mixcolumns step.
+    auto last = [&](std::uint32_t a,
+                    std::uint32_t b,
+                    std::uint32_t c,
+                    std::uint32_t d,
+                    std::size_t column) {
+        return (SUBBOX[a & 0xFF] | (SUBBOX[(b >> 8) & 0xFF] << 8)
+                | (SUBBOX[(c >> 16) & 0xFF] << 16)
+                | (static_cast<std::uint32_t>(SUBBOX[d >> 24]) << 24))
+               ^ rk[AES_ROUNDS][column];
+    };
+
+    state[0] = last(s0, s1, s2, s3, 0);
+    state[1] = last(s1, s2, s3, s0, 1);
+    state[2] = last(s2, s3, s0, s1, 2);
+    state[3] = last(s3, s0, s1, s2, 3);
+}
 } // namespace jrc
@@ -19,6 +19,7 @@
 #include "../Journey.h"
 #include "NetConstants.h"
 
+#include <atomic>
 #include <cstdint>
 
 namespace jrc
@@ -27,6 +28,14 @@ namespace jrc
 class Cryptography
 {
 public:
+    //! Implementations of the cipher, which produce the same output.
+    enum Backend : std::uint8_t {
+        //! Byte-at-a-time implementation, kept as a reference.
+        REFERENCE,
+        //! T-table AES and table-driven shanda passes.
+        TABLE
+    };
+
     //! Obtain the initialization vector from the handshake.
     Cryptography(const std::int8_t* handshake);
     Cryptography();
@@ -41,6 +50,11 @@ public:
     //! Use the 4-byte header of a received packet to determine its length.
     std::size_t check_length(const std::int8_t* header) const;
 
+    //! Select the implementation used by all instances.
+    static void set_backend(Backend backend) noexcept;
+    //! Return the implementation used by all instances.
+    static Backend get_backend() noexcept;
+
 private:
     //! Add the maple custom encryption.
     void mapleencrypt(std::int8_t* bytes, std::size_t length) const noexcept;
@@ -69,6 +83,22 @@ private:
     //! Perform a gauloise multiplication.
     std::uint8_t gmul(std::uint8_t byte) const;
 
+    //! Add the maple custom encryption using lookup tables.
+    void mapleencrypt_table(std::int8_t* bytes, std::size_t length) const
+        noexcept;
+    //! Remove the maple custom encryption using lookup tables.
+    void mapledecrypt_table(std::int8_t* bytes, std::size_t length) const
+        noexcept;
+    //! Apply aesofb to a byte array using T-table AES.
+    void aesofb_table(std::int8_t* bytes,
+                      std::size_t length,
+                      std::uint8_t* iv) const noexcept;
+    //! Encrypt a block, stored as four little-endian columns, with T-table
+    //! AES.
+    void aesencrypt_table(std::uint32_t* state) const noexcept;
+
+    static std::atomic<Backend> backend;
+
 #ifdef JOURNEY_USE_CRYPTO
     std::uint8_t sendiv[HEADER_LENGTH];
     std::uint8_t recviv[HEADER_LENGTH];
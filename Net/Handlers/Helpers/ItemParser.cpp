@@ -95,9 +95,12 @@ void add_equip(InPacket& recv,
     std::uint8_t level = recv.read_byte();
 
     // Read equip stats.
+    std::uint16_t values[Equipstat::LENGTH];
+    recv.read_span(values, Equipstat::LENGTH);
+
     EnumMap<Equipstat::Id, std::uint16_t> stats;
     for (auto iter : stats) {
-        iter.second = recv.read_short();
+        iter.second = values[iter.first];
     }
 
     // Some more information.
@@ -110,12 +113,12 @@ void add_equip(InPacket& recv,
         // Some unused bytes.
         recv.skip(10);
     } else {
-        recv.read_byte();
+        recv.skip(1);
         itemlevel = recv.read_byte();
-        recv.read_short();
+        recv.skip(2);
         itemexp = recv.read_short();
         vicious = recv.read_int();
-        recv.read_long();
+        recv.skip(8);
     }
 
     recv.skip(12);
@@ -146,7 +149,7 @@ void parse_item(InPacket& recv,
                 Inventory& inventory)
 {
     // Read type and item id.
-    recv.read_byte(); // 'type' byte
+    recv.skip(1); // 'type' byte
     std::int32_t iid = recv.read_int();
 
     if (invtype == InventoryType::EQUIP
@@ -57,7 +57,7 @@ World LoginParser::parse_world(InPacket& recv)
     std::uint8_t channelcount = recv.read_byte();
 
     for (std::uint8_t i = 0; i < channelcount; ++i) {
-        recv.read_string(); // channel name
+        recv.read_string_view(); // channel name
         chloads.push_back(recv.read_int());
         recv.skip(1);
         recv.skip(2);
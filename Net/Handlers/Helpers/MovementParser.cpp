@@ -23,19 +23,23 @@ std::vector<Movement> MovementParser::parse_movements(InPacket& recv)
 {
     std::vector<Movement> movements;
     std::uint8_t length = recv.read_byte();
+    movements.reserve(length);
     for (std::uint8_t i = 0; i < length; ++i) {
         Movement fragment;
         fragment.command = recv.read_byte();
+        // Positions and footholds are sent as runs of shorts.
+        std::int16_t values[6];
         switch (fragment.command) {
         case 0:
         case 5:
         case 17:
             fragment.type = Movement::_ABSOLUTE;
-            fragment.xpos = recv.read_short();
-            fragment.ypos = recv.read_short();
-            fragment.lastx = recv.read_short();
-            fragment.lasty = recv.read_short();
-            fragment.fh = recv.read_short();
+            recv.read_span(values, 5);
+            fragment.xpos = values[0];
+            fragment.ypos = values[1];
+            fragment.lastx = values[2];
+            fragment.lasty = values[3];
+            fragment.fh = values[4];
             fragment.newstate = recv.read_byte();
             fragment.duration = recv.read_short();
             break;
@@ -46,27 +50,28 @@ std::vector<Movement> MovementParser::parse_movements(InPacket& recv)
         case 13:
         case 16:
             fragment.type = Movement::_RELATIVE;
-            fragment.xpos = recv.read_short();
-            fragment.ypos = recv.read_short();
+            recv.read_span(values, 2);
+            fragment.xpos = values[0];
+            fragment.ypos = values[1];
             fragment.newstate = recv.read_byte();
             fragment.duration = recv.read_short();
             break;
         case 11:
             fragment.type = Movement::CHAIR;
-            fragment.xpos = recv.read_short();
-            fragment.ypos = recv.read_short();
-            recv.skip(2);
+            recv.read_span(values, 3);
+            fragment.xpos = values[0];
+            fragment.ypos = values[1];
             fragment.newstate = recv.read_byte();
             fragment.duration = recv.read_short();
             break;
         case 15:
             fragment.type = Movement::JUMPDOWN;
-            fragment.xpos = recv.read_short();
-            fragment.ypos = recv.read_short();
-            fragment.lastx = recv.read_short();
-            fragment.lasty = recv.read_short();
-            recv.skip(2);
-            fragment.fh = recv.read_short();
+            recv.read_span(values, 6);
+            fragment.xpos = values[0];
+            fragment.ypos = values[1];
+            fragment.lastx = values[2];
+            fragment.lasty = values[3];
+            fragment.fh = values[5];
             fragment.newstate = recv.read_byte();
             fragment.duration = recv.read_short();
             break;
@@ -31,11 +31,11 @@ void SpawnCharHandler::handle(InPacket& recv) const
     std::uint8_t level = recv.read_byte();
     std::string name = recv.read_string();
 
-    recv.read_string(); // guildname
-    recv.read_short();  // guildlogobg
-    recv.read_byte();   // guildlogobgcolor
-    recv.read_short();  // guildlogo
-    recv.read_byte();   // guildlogocolor
+    recv.read_string_view(); // guildname
+    recv.read_short();       // guildlogobg
+    recv.read_byte();        // guildlogobgcolor
+    recv.read_short();       // guildlogo
+    recv.read_byte();        // guildlogocolor
 
     recv.skip(8);
 
@@ -68,10 +68,10 @@ void SpawnCharHandler::handle(InPacket& recv) const
     for (std::size_t i = 0; i < 3; ++i) {
         std::int8_t available = recv.read_byte();
         if (available == 1) {
-            recv.read_byte();   // 'byte2'
-            recv.read_int();    // petid
-            recv.read_string(); // name
-            recv.read_int();    // unique id
+            recv.read_byte();        // 'byte2'
+            recv.read_int();         // petid
+            recv.read_string_view(); // name
+            recv.read_int();         // unique id
             recv.read_int();
             recv.read_point(); // pos
             recv.read_byte();  // stance
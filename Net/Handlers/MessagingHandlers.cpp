@@ -267,8 +267,8 @@ void ShowItemGainInChatHandler::handle(InPacket& recv) const
         std::cout << "ShowItemGainInChatHandler: maker effect\n" << std::flush;
         break;
     }
-    case 18:                // intro effect
-        recv.read_string(); // path
+    case 18:                     // intro effect
+        recv.read_string_view(); // path
         std::cout << "ShowItemGainInChatHandler: intro effect\n" << std::flush;
         break;
     case 21: { // "show wheels left"
@@ -277,9 +277,9 @@ void ShowItemGainInChatHandler::handle(InPacket& recv) const
                   << std::flush;
         break;
     }
-    case 23:                // show info
-        recv.read_string(); // path
-        recv.read_int();    // dummy int
+    case 23:                     // show info
+        recv.read_string_view(); // path
+        recv.read_int();         // dummy int
         std::cout << "ShowItemGainInChatHandler: show info\n" << std::flush;
         break;
     default: { // buff effect/"show own buff effect"
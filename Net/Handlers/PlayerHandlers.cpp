@@ -44,11 +44,11 @@ void SkillMacrosHandler::handle(InPacket& recv) const
 {
     auto size = static_cast<std::uint8_t>(recv.read_byte());
     for (std::uint8_t i = 0; i < size; ++i) {
-        recv.read_string(); // name
-        recv.read_byte();   // 'shout' byte
-        recv.read_int();    // skill 1
-        recv.read_int();    // skill 2
-        recv.read_int();    // skill 3
+        recv.read_string_view(); // name
+        recv.read_byte();        // 'shout' byte
+        recv.read_int();         // skill 1
+        recv.read_int();         // skill 2
+        recv.read_int();         // skill 3
     }
 }
 
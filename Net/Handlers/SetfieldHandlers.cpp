@@ -48,6 +48,8 @@ void SetfieldHandler::transition(std::int32_t map_id,
 
     GraphicsGL::get().lock();
     Stage::get().clear();
+    // Prepare the player's skills before they are first used.
+    Stage::get().prepare();
     Timer::get().start();
 }
 
@@ -98,7 +100,7 @@ void SetfieldHandler::set_field(InPacket& recv) const
 
     recv.read_byte(); // 'buddycap'
     if (recv.read_bool()) {
-        recv.read_string(); // 'linkedname'
+        recv.read_string_view(); // 'linkedname'
     }
 
     parse_inventory(recv, player.get_inventory());
@@ -221,7 +223,7 @@ void SetfieldHandler::parse_ring1(InPacket& recv) const
     std::int16_t rsize = recv.read_short();
     for (std::int16_t i = 0; i < rsize; ++i) {
         recv.read_int();
-        recv.read_padded_string(13);
+        recv.read_padded_string_view(13);
         recv.read_int();
         recv.read_int();
         recv.read_int();
@@ -234,7 +236,7 @@ void SetfieldHandler::parse_ring2(InPacket& recv) const
     std::int16_t rsize = recv.read_short();
     for (std::int16_t i = 0; i < rsize; ++i) {
         recv.read_int();
-        recv.read_padded_string(13);
+        recv.read_padded_string_view(13);
         recv.read_int();
         recv.read_int();
         recv.read_int();
@@ -253,8 +255,8 @@ void SetfieldHandler::parse_ring3(InPacket& recv) const
         recv.read_short();
         recv.read_int();
         recv.read_int();
-        recv.read_padded_string(13);
-        recv.read_padded_string(13);
+        recv.read_padded_string_view(13);
+        recv.read_padded_string_view(13);
     }
 }
 
@@ -307,7 +309,7 @@ void SetfieldHandler::parse_areainfo(InPacket& recv) const
     std::int16_t ar_size = recv.read_short();
     for (std::int16_t i = 0; i < ar_size; ++i) {
         [[maybe_unused]] std::int16_t area = recv.read_short();
-        recv.read_string(); // area_info[area] = recv.read_string();
+        recv.read_string_view(); // area_info[area] = recv.read_string();
     }
 }
 } // namespace jrc
@@ -17,6 +17,8 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "InPacket.h"
 
+#include <algorithm>
+
 namespace jrc
 {
 InPacket::InPacket(const std::int8_t* recv, std::size_t length) noexcept
@@ -35,12 +37,20 @@ std::size_t InPacket::length() const
 }
 
 void InPacket::skip(std::size_t count) noexcept(false)
+{
+    take(count);
+}
+
+const std::int8_t* InPacket::take(std::size_t count) noexcept(false)
 {
     if (count > length()) {
         throw PacketError("Stack underflow at " + std::to_string(pos));
     }
 
+    const std::int8_t* begin = bytes + pos;
     pos += count;
+
+    return begin;
 }
 
 bool InPacket::read_bool()
@@ -83,31 +93,27 @@ std::string InPacket::read_string()
 
 std::string InPacket::read_string_raw()
 {
-    auto length = read<std::uint16_t>();
-
-    std::string ret;
-    ret.reserve(static_cast<std::string::size_type>(length));
+    return std::string{read_string_view()};
+}
 
-    for (std::uint16_t i = 0; i < length; ++i) {
-        ret.push_back(static_cast<char>(read_byte()));
-    }
+std::string InPacket::read_padded_string(std::uint16_t count)
+{
+    std::string ret{read_padded_string_view(count)};
+    ret.erase(std::remove(ret.begin(), ret.end(), '\0'), ret.end());
 
     return ret;
 }
 
-std::string InPacket::read_padded_string(std::uint16_t count)
+std::string_view InPacket::read_string_view()
 {
-    std::string ret;
-    ret.reserve(static_cast<std::string::size_type>(count));
-
-    for (std::uint16_t i = 0; i < count; ++i) {
-        char letter = static_cast<char>(read_byte());
-        if (letter != '\0') {
-            ret.push_back(letter);
-        }
-    }
+    auto length = read<std::uint16_t>();
+    return read_padded_string_view(length);
+}
 
-    return ret;
+std::string_view InPacket::read_padded_string_view(std::uint16_t count)
+{
+    const auto* begin = reinterpret_cast<const char*>(take(count));
+    return {begin, count};
 }
 
 bool InPacket::inspect_bool()
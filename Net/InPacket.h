@@ -21,7 +21,10 @@
 #include "tinyutf8.h"
 
 #include <cstdint>
+#include <cstring>
 #include <optional>
+#include <string_view>
+#include <type_traits>
 
 namespace jrc
 {
@@ -80,6 +83,29 @@ public:
     //!
     //! Throws a `PacketError` on stack underflow.
     std::string read_padded_string(std::uint16_t length) noexcept(false);
+    //! Read a string as a view into the packet, including padding. The view
+    //! is only valid while the packet is being handled.
+    //!
+    //! Throws a `PacketError` on stack underflow.
+    std::string_view read_string_view() noexcept(false);
+    //! Read a fixed-length string as a view into the packet, including
+    //! padding. The view is only valid while the packet is being handled.
+    //!
+    //! Throws a `PacketError` on stack underflow.
+    std::string_view read_padded_string_view(std::uint16_t length) noexcept(
+        false);
+
+    template<typename T>
+    //! Read `count` consecutive numbers into `dest`.
+    //!
+    //! Throws a `PacketError` on stack underflow.
+    void read_span(T* dest, std::size_t count) noexcept(false)
+    {
+        static_assert(std::is_integral_v<T>,
+                      "InPacket::read_span only reads integers.");
+
+        std::memcpy(dest, take(sizeof(T) * count), sizeof(T) * count);
+    }
 
     //! Inspect a byte and check if it is 1. Does not advance the buffer
     //! position.
@@ -94,22 +120,22 @@ public:
     std::int64_t inspect_long();
 
 private:
+    //! Advance the buffer position, returning the bytes skipped over.
+    //!
+    //! Throws a `PacketError` if `count > length()`.
+    const std::int8_t* take(std::size_t count) noexcept(false);
+
     template<typename T>
-    //! Read a number and advance the buffer position.
+    //! Read a number and advance the buffer position. Numbers are sent in
+    //! little-endian order, same as the byte order of supported platforms.
     //!
     //! Throws a `PacketError` on stack underflow.
     T read() noexcept(false)
     {
-        constexpr const std::size_t count = sizeof(T);
-        T all = 0;
-        for (std::size_t i = 0; i < count; ++i) {
-            T val = static_cast<std::uint8_t>(bytes[pos]);
-            all |= val << (i << 3);
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
 
-            skip(1);
-        }
-
-        return all;
+        return value;
     }
 
     template<typename T>
@@ -23,21 +23,19 @@
 
 namespace jrc
 {
-OutPacket::OutPacket(std::int16_t opcode)
+OutPacket::OutPacket(std::int16_t opcode) : bytes(Session::get().acquire())
 {
     write_short(opcode);
 }
 
 bool OutPacket::dispatch() noexcept
 {
-    return Session::get().write(bytes.data(), bytes.size());
+    return Session::get().write(std::move(bytes));
 }
 
 void OutPacket::skip(std::size_t count)
 {
-    for (std::size_t i = 0; i < count; ++i) {
-        bytes.push_back(0);
-    }
+    bytes.resize(bytes.size() + count);
 }
 
 void OutPacket::write_byte(std::int8_t ch)
@@ -47,26 +45,17 @@ void OutPacket::write_byte(std::int8_t ch)
 
 void OutPacket::write_short(std::int16_t sh)
 {
-    for (std::size_t i = 0; i < 2; ++i) {
-        write_byte(static_cast<std::int8_t>(sh));
-        sh >>= 8;
-    }
+    write<std::int16_t>(sh);
 }
 
 void OutPacket::write_int(std::int32_t in)
 {
-    for (std::size_t i = 0; i < 4; ++i) {
-        write_byte(static_cast<std::int8_t>(in));
-        in >>= 8;
-    }
+    write<std::int32_t>(in);
 }
 
 void OutPacket::write_long(std::int64_t lg)
 {
-    for (std::size_t i = 0; i < 8; ++i) {
-        write_byte(static_cast<std::int8_t>(lg));
-        lg >>= 8;
-    }
+    write<std::int64_t>(lg);
 }
 
 void OutPacket::write_time()
@@ -89,8 +78,6 @@ void OutPacket::write_string(std::string_view str)
     std::int16_t length = static_cast<std::int16_t>(str.length());
     write_short(length);
 
-    for (std::int16_t i = 0; i < length; ++i) {
-        write_byte(str[i]);
-    }
+    bytes.insert(bytes.end(), str.begin(), str.end());
 }
 } // namespace jrc
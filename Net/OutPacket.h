@@ -19,6 +19,7 @@
 #include "../Template/Point.h"
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -31,9 +32,12 @@ class OutPacket
 public:
     enum Opcode : std::uint16_t;
 
-    //! Construct a packet by writing its opcode.
+    //! Construct a packet by writing its opcode. The buffer is taken from
+    //! the session's pool and has room for the header in front.
     OutPacket(std::int16_t opcode);
 
+    //! Hand the packet over to the session for sending. The packet is empty
+    //! afterwards.
     bool dispatch() noexcept;
 
 protected:
@@ -57,6 +61,16 @@ protected:
     void write_string(std::string_view str);
 
 private:
+    template<typename T>
+    //! Append a number in little-endian order, same as the byte order of
+    //! supported platforms.
+    void write(T value)
+    {
+        std::size_t pos = bytes.size();
+        bytes.resize(pos + sizeof(T));
+        std::memcpy(bytes.data() + pos, &value, sizeof(T));
+    }
+
     std::vector<std::int8_t> bytes;
 };
 
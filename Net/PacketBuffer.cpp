@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "PacketBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace jrc
+{
+PacketBuffer::PacketBuffer()
+    : bytes(std::make_unique<std::int8_t[]>(CAPACITY)), head(0), count(0)
+{
+}
+
+bool PacketBuffer::write(const std::int8_t* src, std::size_t length) noexcept
+{
+    if (length > free_space()) {
+        return false;
+    }
+
+    // The free space may wrap around the end of the buffer.
+    std::size_t tail = (head + count) % CAPACITY;
+    std::size_t first = std::min(length, CAPACITY - tail);
+
+    std::memcpy(bytes.get() + tail, src, first);
+    std::memcpy(bytes.get(), src + first, length - first);
+
+    count += length;
+
+    return true;
+}
+
+bool PacketBuffer::peek(std::int8_t* dest, std::size_t length) const noexcept
+{
+    if (length > count) {
+        return false;
+    }
+
+    std::size_t first = std::min(length, CAPACITY - head);
+
+    std::memcpy(dest, bytes.get() + head, first);
+    std::memcpy(dest + first, bytes.get(), length - first);
+
+    return true;
+}
+
+bool PacketBuffer::read(std::int8_t* dest, std::size_t length) noexcept
+{
+    return peek(dest, length) && skip(length);
+}
+
+bool PacketBuffer::skip(std::size_t length) noexcept
+{
+    if (length > count) {
+        return false;
+    }
+
+    head = (head + length) % CAPACITY;
+    count -= length;
+
+    if (count == 0) {
+        head = 0;
+    }
+
+    return true;
+}
+
+void PacketBuffer::clear() noexcept
+{
+    head = 0;
+    count = 0;
+}
+
+std::size_t PacketBuffer::size() const noexcept
+{
+    return count;
+}
+
+std::size_t PacketBuffer::free_space() const noexcept
+{
+    return CAPACITY - count;
+}
+} // namespace jrc
@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "NetConstants.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace jrc
+{
+//! Ring buffer which collects bytes received from the server until they form
+//! complete packets.
+class PacketBuffer
+{
+public:
+    //! Enough room for a few maximum length packets to be in flight.
+    static constexpr const std::size_t CAPACITY = 4 * MAX_PACKET_LENGTH;
+
+    PacketBuffer();
+
+    //! Append received bytes. Returns false if they do not fit.
+    bool write(const std::int8_t* bytes, std::size_t count) noexcept;
+    //! Copy bytes from the front of the buffer without consuming them.
+    bool peek(std::int8_t* dest, std::size_t count) const noexcept;
+    //! Copy bytes from the front of the buffer and consume them.
+    bool read(std::int8_t* dest, std::size_t count) noexcept;
+    //! Consume bytes from the front of the buffer.
+    bool skip(std::size_t count) noexcept;
+    //! Discard all bytes.
+    void clear() noexcept;
+
+    //! Return the number of bytes which have not been read yet.
+    std::size_t size() const noexcept;
+    //! Return the number of bytes which can still be written.
+    std::size_t free_space() const noexcept;
+
+private:
+    std::unique_ptr<std::int8_t[]> bytes;
+    std::size_t head;
+    std::size_t count;
+};
+} // namespace jrc
@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "PacketLog.h"
+
+#include "NetConstants.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace jrc
+{
+namespace
+{
+void write_u32(std::ofstream& file, std::uint32_t value)
+{
+    char bytes[4];
+    for (std::size_t i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    file.write(bytes, 4);
+}
+
+bool read_u32(std::ifstream& file, std::uint32_t& value)
+{
+    unsigned char bytes[4];
+    if (!file.read(reinterpret_cast<char*>(bytes), 4)) {
+        return false;
+    }
+
+    value = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+    }
+
+    return true;
+}
+} // namespace
+
+bool PacketLogWriter::open(const std::string& filename)
+{
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    file.write(PacketLog::MAGIC, sizeof(PacketLog::MAGIC));
+    write_u32(file, PacketLog::VERSION);
+    last = std::chrono::steady_clock::now();
+
+    return static_cast<bool>(file);
+}
+
+PacketLogWriter::operator bool() const noexcept
+{
+    return file.is_open();
+}
+
+void PacketLogWriter::write(const std::int8_t* bytes, std::size_t length)
+{
+    auto now = std::chrono::steady_clock::now();
+    auto delay
+        = std::chrono::duration_cast<std::chrono::microseconds>(now - last)
+              .count();
+    last = now;
+
+    write_u32(file,
+              static_cast<std::uint32_t>(
+                  std::min<std::int64_t>(delay, UINT32_MAX)));
+    write_u32(file, static_cast<std::uint32_t>(length));
+    file.write(reinterpret_cast<const char*>(bytes), length);
+}
+
+bool PacketLogReader::open(const std::string& filename)
+{
+    file.open(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char magic[sizeof(PacketLog::MAGIC)];
+    std::uint32_t version = 0;
+    if (!file.read(magic, sizeof(magic)) || !read_u32(file, version)) {
+        return false;
+    }
+
+    return std::memcmp(magic, PacketLog::MAGIC, sizeof(magic)) == 0
+           && version == PacketLog::VERSION;
+}
+
+bool PacketLogReader::next(std::vector<std::int8_t>& packet,
+                           std::int64_t& delay)
+{
+    std::uint32_t micros = 0;
+    std::uint32_t length = 0;
+    if (!read_u32(file, micros) || !read_u32(file, length)
+        || length > MAX_PACKET_LENGTH) {
+        return false;
+    }
+
+    packet.resize(length);
+    if (!file.read(reinterpret_cast<char*>(packet.data()), length)) {
+        return false;
+    }
+
+    delay = micros;
+
+    return true;
+}
+} // namespace jrc
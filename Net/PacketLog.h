@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace jrc
+{
+//! Binary log of decrypted inbound packets, for replaying captured traffic
+//! without a server.
+//!
+//! A log starts with the four bytes `JPKT` and a 32-bit format version. Each
+//! packet follows as a record of
+//!
+//!     u32 microseconds since the previous packet was received
+//!     u32 length of the packet
+//!     the packet, beginning with its 16-bit opcode
+//!
+//! All integers are little-endian.
+namespace PacketLog
+{
+constexpr const char MAGIC[4] = {'J', 'P', 'K', 'T'};
+constexpr const std::uint32_t VERSION = 1;
+} // namespace PacketLog
+
+//! Appends packets to a log as they are received.
+class PacketLogWriter
+{
+public:
+    //! Create or truncate the log at `filename`. Returns false if the file
+    //! could not be opened.
+    bool open(const std::string& filename);
+    //! Whether a log is open.
+    explicit operator bool() const noexcept;
+
+    //! Append a packet, timestamped with the current time.
+    void write(const std::int8_t* bytes, std::size_t length);
+
+private:
+    std::ofstream file;
+    std::chrono::steady_clock::time_point last;
+};
+
+//! Reads the packets of a log in order.
+class PacketLogReader
+{
+public:
+    //! Open the log at `filename`. Returns false if the file could not be
+    //! opened or is not a packet log.
+    bool open(const std::string& filename);
+
+    //! Read the next packet into `packet`, and the microseconds between its
+    //! reception and that of the previous one into `delay`. Returns false at
+    //! the end of the log or if the record is truncated.
+    bool next(std::vector<std::int8_t>& packet, std::int64_t& delay);
+
+private:
+    std::ifstream file;
+};
+} // namespace jrc
@@ -18,6 +18,8 @@
 #include "PacketSwitch.h"
 
 #include "../Console.h"
+#include "../Util/Allocations.h"
+#include "../Util/Profiler.h"
 #include "Handlers/AttackHandlers.h"
 #include "Handlers/CommonHandlers.h"
 #include "Handlers/InventoryHandlers.h"
@@ -28,7 +30,11 @@
 #include "Handlers/PlayerHandlers.h"
 #include "Handlers/SetfieldHandlers.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <iomanip>
+#include <numeric>
 
 namespace jrc
 {
@@ -237,6 +243,13 @@ void PacketSwitch::forward(const std::int8_t* bytes, std::size_t length) const
 
     if (opcode < NUM_HANDLERS) {
         if (auto& handler = handlers[opcode]; handler) {
+            bool measure = Profiler::get().is_enabled();
+            std::size_t allocations = Allocations::count();
+            std::chrono::steady_clock::time_point start;
+            if (measure) {
+                start = std::chrono::steady_clock::now();
+            }
+
             // Handler ok. Packet is passed on.
             try {
                 handler->handle(recv);
@@ -244,6 +257,21 @@ void PacketSwitch::forward(const std::int8_t* bytes, std::size_t length) const
                 // Log a notice about an error.
                 warn(err.what(), opcode);
             }
+
+            if (measure) {
+                std::int64_t time
+                    = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+
+                OpcodeStats& opcode_stats = stats[opcode];
+                ++opcode_stats.count;
+                opcode_stats.bytes += length;
+                opcode_stats.total_time += time;
+                opcode_stats.max_time = std::max(opcode_stats.max_time, time);
+                opcode_stats.allocations
+                    += Allocations::count() - allocations;
+            }
         } else {
             // Warn about an unhandled packet.
             warn(MSG_UNHANDLED, opcode);
@@ -254,6 +282,68 @@ void PacketSwitch::forward(const std::int8_t* bytes, std::size_t length) const
     }
 }
 
+const PacketSwitch::OpcodeStats*
+PacketSwitch::get_stats(std::uint16_t opcode) const noexcept
+{
+    return opcode < NUM_HANDLERS ? &stats[opcode] : nullptr;
+}
+
+std::vector<std::uint16_t> PacketSwitch::get_slowest(std::size_t count) const
+{
+    std::vector<std::uint16_t> opcodes(NUM_HANDLERS);
+    std::iota(opcodes.begin(), opcodes.end(), 0);
+    opcodes.erase(std::remove_if(opcodes.begin(),
+                                 opcodes.end(),
+                                 [&](std::uint16_t opcode) {
+                                     return stats[opcode].count == 0;
+                                 }),
+                  opcodes.end());
+
+    auto by_max_time = [&](std::uint16_t a, std::uint16_t b) {
+        return stats[a].max_time > stats[b].max_time;
+    };
+    count = std::min(count, opcodes.size());
+    std::partial_sort(
+        opcodes.begin(), opcodes.begin() + count, opcodes.end(), by_max_time);
+    opcodes.resize(count);
+
+    return opcodes;
+}
+
+void PacketSwitch::reset_stats() noexcept
+{
+    stats.fill({});
+}
+
+void PacketSwitch::dump_stats(std::ostream& os) const
+{
+    std::vector<std::uint16_t> opcodes;
+    for (std::uint16_t opcode = 0; opcode < NUM_HANDLERS; ++opcode) {
+        if (stats[opcode].count) {
+            opcodes.push_back(opcode);
+        }
+    }
+
+    std::sort(opcodes.begin(),
+              opcodes.end(),
+              [&](std::uint16_t a, std::uint16_t b) {
+                  return stats[a].total_time > stats[b].total_time;
+              });
+
+    os << "opcode     count     bytes  total ms    avg us    max us"
+          "  allocs/packet\n";
+    for (std::uint16_t opcode : opcodes) {
+        const OpcodeStats& s = stats[opcode];
+        os << std::left << std::setw(6) << str::to_hex(opcode) << std::right
+           << std::fixed << std::setprecision(2) << std::setw(10) << s.count
+           << std::setw(10) << s.bytes << std::setw(10)
+           << s.total_time / 1e6 << std::setw(10)
+           << s.total_time / 1e3 / s.count << std::setw(10)
+           << s.max_time / 1e3 << std::setw(15)
+           << static_cast<double>(s.allocations) / s.count << '\n';
+    }
+}
+
 void PacketSwitch::warn(std::string_view message, std::size_t opcode) const
     noexcept
 {
@@ -20,7 +20,9 @@
 
 #include <array>
 #include <memory>
+#include <ostream>
 #include <type_traits>
+#include <vector>
 
 namespace jrc
 {
@@ -34,6 +36,29 @@ public:
     //! Forward a packet to the correct handler.
     void forward(const std::int8_t* bytes, std::size_t length) const;
 
+    //! Statistics of the packets handled for one opcode, recorded while the
+    //! `Profiler` is enabled.
+    struct OpcodeStats {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+        //! Time spent in the handler, in nanoseconds.
+        std::int64_t total_time = 0;
+        std::int64_t max_time = 0;
+        //! Heap allocations made by the handler.
+        std::size_t allocations = 0;
+    };
+
+    //! Return the statistics of an opcode, or `nullptr` if it is out of
+    //! range.
+    const OpcodeStats* get_stats(std::uint16_t opcode) const noexcept;
+    //! Return the opcodes with the highest maximum handler time, slowest
+    //! first, up to `count` of them.
+    std::vector<std::uint16_t> get_slowest(std::size_t count) const;
+    void reset_stats() noexcept;
+    //! Write the statistics of every opcode handled so far as a table,
+    //! sorted by total handler time.
+    void dump_stats(std::ostream& os) const;
+
 private:
     //! Print a warning to the console about something strange or amiss in
     //! the packet switcher.
@@ -54,6 +79,7 @@ private:
     static constexpr const std::size_t NUM_HANDLERS = 500;
 
     std::array<std::unique_ptr<PacketHandler>, NUM_HANDLERS> handlers;
+    mutable std::array<OpcodeStats, NUM_HANDLERS> stats;
 
     //! Register a handler for the specified opcode.
     template<std::size_t O, typename T, typename... Args>
@@ -18,16 +18,25 @@
 #include "Session.h"
 
 #include "../Configuration.h"
+#include "../Util/Profiler.h"
+
+#include <chrono>
+#include <thread>
 
 namespace jrc
 {
-Session::Session() noexcept : length(0), pos(0), connected(false)
+Session::Session() noexcept
+    : dispatch_budget(Configuration::Network{}.dispatch_budget),
+      replaying(false),
+      running(false), connected(false)
 {
 }
 
 Session::~Session() noexcept
 {
-    if (connected) {
+    stop();
+
+    if (connected && !replaying) {
         socket.close();
     }
 }
@@ -36,10 +45,14 @@ bool Session::init(const char* host, const char* port)
 {
     // Connect to the server.
     connected = socket.open(host, port);
+    received.clear();
 
     if (connected) {
         // Read keys neccessary for communicating with the server.
         cryptography = {socket.get_buffer()};
+
+        running = true;
+        io_thread = std::thread(&Session::run, this);
     }
 
     return connected;
@@ -47,7 +60,19 @@ bool Session::init(const char* host, const char* port)
 
 Error Session::init()
 {
-    const std::string& host = Configuration::get().network.ip;
+    const Configuration::Network& network = Configuration::get().network;
+    set_dispatch_budget(network.dispatch_budget);
+
+    if (!network.replay.empty()) {
+        return init_replay(network.replay, network.replay_realtime);
+    }
+
+    if (!network.capture.empty() && !capture.open(network.capture)) {
+        Console::get().print("Could not open the packet capture file "
+                             + network.capture);
+    }
+
+    const std::string& host = network.ip;
     if (host.empty()) {
         Console::get().print("No host IP was found in the settings file.");
         return Error::CONNECTION;
@@ -63,8 +88,33 @@ Error Session::init()
     return Error::NONE;
 }
 
+Error Session::init_replay(const std::string& filename, bool realtime)
+{
+    stop();
+
+    if (!replay.open(filename)) {
+        return {Error::MISSING_FILE, filename.c_str()};
+    }
+
+    replaying = true;
+    connected = true;
+    running = true;
+    io_thread = std::thread(&Session::run_replay, this, realtime);
+
+    return Error::NONE;
+}
+
 void Session::reconnect(const char* address, const char* port)
 {
+    // A replayed log already contains the packets of the next server.
+    if (replaying) {
+        return;
+    }
+
+    // Packets already sent are flushed by the I/O thread before it stops,
+    // packets received from the old server are discarded.
+    stop();
+
     // Close the current connection and open a new one.
     bool success = socket.close();
 
@@ -75,83 +125,216 @@ void Session::reconnect(const char* address, const char* port)
     }
 }
 
-void Session::process(const std::int8_t* bytes, std::size_t available)
+void Session::stop()
 {
-    if (pos == 0) {
-        // Pos is 0, meaning this is the start of a new packet.
-        // Start by determining length.
-        length = cryptography.check_length(bytes);
-        // Reading the length means we processed the header.
-        // Move forward by the header length.
-        bytes = bytes + HEADER_LENGTH;
-        available -= HEADER_LENGTH;
+    running = false;
+
+    if (io_thread.joinable()) {
+        io_thread.join();
     }
 
-    // Determine how much we can write. Write data into the buffer.
-    std::size_t towrite = length - pos;
+    inbound.clear();
+    outbound.clear();
+    recycled.clear();
+}
+
+void Session::run()
+{
+    while (running && connected) {
+        if (!send()) {
+            connected = false;
+            break;
+        }
+
+        // Move everything the socket has received into the buffer. Each
+        // receive may return up to a maximum length packet.
+        bool idle = true;
+        while (received.free_space() >= MAX_PACKET_LENGTH) {
+            bool ok = true;
+            std::size_t result = socket.receive(&ok);
+
+            if (!ok) {
+                connected = false;
+            }
+            if (result == 0) {
+                break;
+            }
+
+            received.write(socket.get_buffer(), result);
+            idle = false;
+        }
+
+        bool framed = false;
+        if (!frame(&framed)) {
+            connected = false;
+        }
+
+        if (idle && !framed) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
 
-    if (towrite > available) {
-        towrite = available;
+    if (connected) {
+        send();
     }
+}
 
-    memcpy(buffer + pos, bytes, towrite);
-    pos += towrite;
+void Session::run_replay(bool realtime)
+{
+    Packet packet;
+    std::int64_t delay = 0;
+    auto due = std::chrono::steady_clock::now();
 
-    // Check if the current packet has been fully processed.
-    if (pos >= length) {
-        cryptography.decrypt(buffer, length);
+    while (running && replay.next(packet, delay)) {
+        if (realtime) {
+            due += std::chrono::microseconds(delay);
+            std::this_thread::sleep_until(due);
+        }
 
-        try {
-            packet_switch.forward(buffer, length);
-        } catch (const PacketError& err) {
-            Console::get().print(err.what());
+        // Wait for the game thread to make room, as the socket would.
+        while (running && !inbound.push(std::move(packet))) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // There is no server to send to.
+        Packet sent;
+        while (outbound.pop(sent)) {
+            sent.clear();
+            recycled.push(std::move(sent));
+        }
+    }
+
+    // Stay connected until the game has handled everything.
+    while (running && !inbound.drained()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    connected = false;
+}
+
+bool Session::send()
+{
+    Packet packet;
+
+    while (outbound.pop(packet)) {
+        // The header is written into the space reserved in front of the
+        // body, so that the whole packet goes out with a single write.
+        std::size_t length = packet.size() - HEADER_LENGTH;
+        cryptography.create_header(packet.data(), length);
+        cryptography.encrypt(packet.data() + HEADER_LENGTH, length);
+
+        if (!socket.dispatch(packet.data(), packet.size())) {
+            return false;
+        }
+
+        packet.clear();
+        recycled.push(std::move(packet));
+    }
+
+    return true;
+}
+
+bool Session::frame(bool* framed)
+{
+    // Stop when the game thread falls behind, the remaining packets stay in
+    // the receive buffer.
+    while (received.size() >= HEADER_LENGTH && !inbound.full()) {
+        // The header stays in the buffer until the whole packet has arrived.
+        std::int8_t header[HEADER_LENGTH];
+        received.peek(header, HEADER_LENGTH);
+
+        std::size_t length = cryptography.check_length(header);
+
+        if (length > MAX_PACKET_LENGTH) {
+            Console::get().print("Received a packet with invalid length.");
+            received.clear();
+            return false;
+        }
+
+        if (received.size() < HEADER_LENGTH + length) {
+            break;
         }
 
-        pos = 0;
-        length = 0;
+        Packet packet(length);
 
-        // Check if there is more available.
-        const std::size_t remaining = available - towrite;
+        received.skip(HEADER_LENGTH);
+        received.read(packet.data(), length);
 
-        if (remaining >= MIN_PACKET_LENGTH) {
-            // More packets are available, so we start over.
-            process(bytes + towrite, remaining);
+        cryptography.decrypt(packet.data(), length);
+        if (capture) {
+            capture.write(packet.data(), length);
         }
+
+        inbound.push(std::move(packet));
+        *framed = true;
+    }
+
+    return true;
+}
+
+Session::Packet Session::acquire()
+{
+    Packet packet;
+    if (!recycled.pop(packet)) {
+        packet.reserve(PACKET_CAPACITY);
     }
+
+    packet.resize(HEADER_LENGTH);
+
+    return packet;
 }
 
-bool Session::write(std::int8_t* packet_bytes,
-                    std::size_t packet_length) noexcept
+bool Session::write(Packet&& packet) noexcept
 {
     if (!connected) {
         return false;
     }
 
-    std::int8_t header[HEADER_LENGTH];
-    cryptography.create_header(header, packet_length);
-    cryptography.encrypt(packet_bytes, packet_length);
-
-    if (!socket.dispatch(header, HEADER_LENGTH)) {
+    // The I/O thread has stopped sending, so the connection is treated as
+    // lost rather than dropping the packet.
+    if (!outbound.push(std::move(packet))) {
+        Console::get().print("The outbound packet queue is full.");
+        connected = false;
         return false;
     }
-    return socket.dispatch(packet_bytes, packet_length);
+
+    return true;
 }
 
 void Session::read()
 {
-    // Check if a packet has arrived. Handle if data is sufficient:
-    //     4 bytes(header) + 2 bytes(opcode) = 6.
-    std::size_t result = socket.receive(&connected);
+    ProfileScope scope{"Session::read"};
+
+    auto start = std::chrono::steady_clock::now();
+
+    Packet packet;
+    while (inbound.pop(packet)) {
+        try {
+            packet_switch.forward(packet.data(), packet.size());
+        } catch (const PacketError& err) {
+            Console::get().print(err.what());
+        }
 
-    if (result >= MIN_PACKET_LENGTH || length > 0) {
-        // Retrieve buffer from the socket and process it.
-        const std::int8_t* bytes = socket.get_buffer();
-        process(bytes, result);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        if (elapsed.count() >= dispatch_budget) {
+            break;
+        }
     }
 }
 
+void Session::set_dispatch_budget(std::int64_t microseconds) noexcept
+{
+    dispatch_budget = microseconds;
+}
+
 bool Session::is_connected() const noexcept
 {
     return connected;
 }
+
+PacketSwitch& Session::get_packet_switch() noexcept
+{
+    return packet_switch;
+}
 } // namespace jrc
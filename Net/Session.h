@@ -19,7 +19,10 @@
 #include "../Error.h"
 #include "../Journey.h"
 #include "../Template/Singleton.h"
+#include "../Template/SpscQueue.h"
 #include "Cryptography.h"
+#include "PacketBuffer.h"
+#include "PacketLog.h"
 #include "PacketSwitch.h"
 #ifdef JOURNEY_USE_ASIO
 #    include "SocketAsio.h"
@@ -27,36 +30,89 @@
 #    include "SocketWinsock.h"
 #endif
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace jrc
 {
+//! Connection to the server. Sending, receiving and decrypting happens on a
+//! separate I/O thread, packets are handled on the game thread by `read()`.
 class Session : public Singleton<Session>
 {
 public:
+    //! Buffer holding one packet.
+    using Packet = std::vector<std::int8_t>;
+
     Session() noexcept;
     ~Session() noexcept override;
 
-    //! Connect using host and port from the configuration file.
+    //! Connect using host and port from the configuration file, or replay
+    //! a packet log if one is configured.
     Error init();
-    //! Send a packet to the server.
-    bool write(std::int8_t* bytes, std::size_t length) noexcept;
-    //! Check for incoming packets and handle them.
+    //! Feed the packets logged in `filename` to the game instead of those
+    //! of a server, either with their original timing or as fast as they
+    //! are handled. Outgoing packets are discarded. The session counts as
+    //! connected until all logged packets have been handled.
+    Error init_replay(const std::string& filename, bool realtime);
+    //! Return an empty buffer for an outgoing packet, reusing one which has
+    //! already been sent if possible. The buffer starts with room for the
+    //! header.
+    Packet acquire();
+    //! Queue a packet to be sent to the server by the I/O thread. The packet
+    //! must have been obtained from `acquire()`. Disconnects and returns
+    //! `false` if the queue is full.
+    bool write(Packet&& packet) noexcept;
+    //! Handle packets which have been received by the I/O thread.
     void read();
+    //! Set how many microseconds may be spent handling packets per call to
+    //! read. Packets left over are handled on the next call.
+    void set_dispatch_budget(std::int64_t microseconds) noexcept;
     //! Closes the current connection and opens a new one.
     void reconnect(const char* address, const char* port);
     //! Check if the connection is alive.
     bool is_connected() const noexcept;
+    //! Return the dispatcher of inbound packets, e.g. for its statistics.
+    PacketSwitch& get_packet_switch() noexcept;
 
 private:
     bool init(const char* host, const char* port);
-    void process(const std::int8_t* bytes, std::size_t available);
+    //! Stop the I/O thread and discard all queued packets.
+    void stop();
+    //! Main loop of the I/O thread.
+    void run();
+    //! Main loop of the I/O thread when replaying a packet log.
+    void run_replay(bool realtime);
+    //! Encrypt and send all queued outgoing packets.
+    bool send();
+    //! Move all complete packets from the receive buffer to the inbound
+    //! queue, decrypting them on the way. Returns false if the stream is
+    //! corrupted.
+    bool frame(bool* framed);
+
+    static constexpr const std::size_t QUEUE_LENGTH = 1024;
+    static constexpr const std::size_t PACKET_CAPACITY = 256;
 
+    // Only used by the I/O thread while it is running.
     Cryptography cryptography;
+    PacketBuffer received;
+    PacketLogWriter capture;
+    PacketLogReader replay;
+
+    // Only used by the game thread.
     PacketSwitch packet_switch;
+    std::int64_t dispatch_budget;
+    bool replaying;
+
+    SpscQueue<Packet, QUEUE_LENGTH> inbound;
+    SpscQueue<Packet, QUEUE_LENGTH> outbound;
+    // Sent packets, returned to the game thread for reuse.
+    SpscQueue<Packet, QUEUE_LENGTH> recycled;
 
-    std::int8_t buffer[MAX_PACKET_LENGTH];
-    std::size_t length;
-    std::size_t pos;
-    bool connected;
+    std::thread io_thread;
+    std::atomic<bool> running;
+    std::atomic<bool> connected;
 
 #ifdef JOURNEY_USE_ASIO
     SocketAsio socket;
@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace jrc
+{
+template<typename T>
+//! Values for the frames of a number of slots, eg. one for each stance and
+//! layer of a look part. Frames are small dense integers, so instead of a
+//! map per slot, the values of all slots are kept in one contiguous array,
+//! ordered by slot and frame, and found through a table of offsets. A frame
+//! may hold any number of values.
+class FrameTable
+{
+public:
+    //! Collects values in any order, to then build a table from them.
+    class Builder
+    {
+    public:
+        //! Add a value to a frame of a slot. Values of the same frame keep
+        //! the order they were added in.
+        template<typename... Args>
+        T& add(std::size_t slot, std::uint8_t frame, Args&&... args)
+        {
+            return entries
+                .emplace_back(slot,
+                              frame,
+                              entries.size(),
+                              T(std::forward<Args>(args)...))
+                .value;
+        }
+
+        //! Build a table with the specified number of slots. Values of
+        //! slots past these are dropped.
+        FrameTable build(std::size_t slots)
+        {
+            std::sort(entries.begin(),
+                      entries.end(),
+                      [](const Entry& a, const Entry& b) {
+                          return std::tie(a.slot, a.frame, a.order)
+                                 < std::tie(b.slot, b.frame, b.order);
+                      });
+
+            // The offsets of the slots come first, followed by those of
+            // their frames. A slot covers frame offsets up to the first of
+            // the next slot, and a frame covers values up to the first of
+            // the next frame.
+            std::vector<std::uint32_t> starts(slots + 1, 0);
+            std::vector<T> values;
+            values.reserve(entries.size());
+
+            std::size_t first = 0;
+            for (std::size_t slot = 0; slot < slots; ++slot) {
+                starts[slot] = static_cast<std::uint32_t>(starts.size());
+
+                std::size_t last = first;
+                while (last < entries.size() && entries[last].slot == slot) {
+                    ++last;
+                }
+
+                if (last > first) {
+                    std::size_t frames = entries[last - 1].frame + 1u;
+                    for (std::size_t frame = 0; frame < frames; ++frame) {
+                        starts.push_back(
+                            static_cast<std::uint32_t>(values.size()));
+                        while (first < last && entries[first].frame == frame) {
+                            values.push_back(std::move(entries[first].value));
+                            ++first;
+                        }
+                    }
+                }
+            }
+
+            starts[slots] = static_cast<std::uint32_t>(starts.size());
+            starts.push_back(static_cast<std::uint32_t>(values.size()));
+            entries.clear();
+
+            return {std::move(starts), std::move(values)};
+        }
+
+    private:
+        struct Entry {
+            Entry(std::size_t s, std::uint8_t f, std::size_t o, T&& v)
+                : slot{s}, frame{f}, order{o}, value{std::move(v)}
+            {
+            }
+
+            std::size_t slot;
+            std::uint8_t frame;
+            std::size_t order;
+            T value;
+        };
+
+        std::vector<Entry> entries;
+    };
+
+    FrameTable() noexcept = default;
+
+    //! Return the number of frames of a slot, including frames without
+    //! values below the last one with values.
+    std::size_t frames(std::size_t slot) const noexcept
+    {
+        if (slot + 1 >= slot_end()) {
+            return 0;
+        }
+
+        return starts[slot + 1] - starts[slot];
+    }
+
+    //! Return the first value of a frame, or `nullptr` if it has none.
+    const T* find(std::size_t slot, std::uint8_t frame) const noexcept
+    {
+        auto [first, last] = range(slot, frame);
+        return first == last ? nullptr : first;
+    }
+
+    //! Return pointers to the first value of a frame and past its last.
+    std::pair<const T*, const T*> range(std::size_t slot,
+                                        std::uint8_t frame) const noexcept
+    {
+        if (frame >= frames(slot)) {
+            return {nullptr, nullptr};
+        }
+
+        std::size_t index = starts[slot] + frame;
+        return {values.data() + starts[index],
+                values.data() + starts[index + 1]};
+    }
+
+private:
+    FrameTable(std::vector<std::uint32_t>&& s, std::vector<T>&& v) noexcept
+        : starts{std::move(s)}, values{std::move(v)}
+    {
+    }
+
+    //! Return the index one past the offset of the last slot.
+    std::size_t slot_end() const noexcept
+    {
+        return starts.empty() ? 0 : starts[0];
+    }
+
+    std::vector<std::uint32_t> starts;
+    std::vector<T> values;
+};
+} // namespace jrc
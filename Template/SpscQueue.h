@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace jrc
+{
+//! Fixed capacity queue for passing values from one producer thread to one
+//! consumer thread without locking.
+//!
+//! Only the producer may call `push()`, `full()` and `drained()`, only the
+//! consumer may call `pop()` and `empty()`. `clear()` may only be used while
+//! neither thread is accessing the queue.
+template<typename T, std::size_t N>
+class SpscQueue
+{
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0,
+                  "SpscQueue capacity must be a power of two.");
+
+    //! Move a value into the queue. Returns false and leaves the value
+    //! untouched if the queue is full.
+    bool push(T&& value) noexcept
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+
+        slots[t & (N - 1)] = std::move(value);
+        tail.store(t + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //! Move the oldest value out of the queue. Returns false if the queue is
+    //! empty.
+    bool pop(T& value) noexcept
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = std::move(slots[h & (N - 1)]);
+        head.store(h + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool full() const noexcept
+    {
+        return tail.load(std::memory_order_relaxed)
+                   - head.load(std::memory_order_acquire)
+               == N;
+    }
+
+    //! Whether the consumer has taken every value pushed so far.
+    bool drained() const noexcept
+    {
+        return tail.load(std::memory_order_relaxed)
+               == head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept
+    {
+        return head.load(std::memory_order_relaxed)
+               == tail.load(std::memory_order_acquire);
+    }
+
+    void clear() noexcept
+    {
+        T discarded;
+        while (pop(discarded)) {
+        }
+    }
+
+private:
+    std::array<T, N> slots;
+    // Keep the indices on separate cache lines, so the threads do not
+    // invalidate each other's cache on every operation.
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+};
+} // namespace jrc
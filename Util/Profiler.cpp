@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace jrc
+{
+namespace
+{
+std::int64_t nanoseconds(Profiler::clock::duration duration) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+        .count();
+}
+} // namespace
+
+Profiler::Profiler()
+    : enabled{false}, epoch{clock::now()}, frame_start{0}, frame_count{0}
+{
+}
+
+void Profiler::set_enabled(bool enable) noexcept
+{
+    if (enable && !is_enabled()) {
+        frame_start = nanoseconds(clock::now() - epoch);
+        frame_count = 0;
+        phases.clear();
+    }
+
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+void Profiler::record(const char* name,
+                      std::uint8_t depth,
+                      clock::time_point start,
+                      clock::time_point end)
+{
+    Ring& ring = local_ring();
+    Event event{
+        name, depth, nanoseconds(start - epoch), nanoseconds(end - start)};
+
+    std::lock_guard<std::mutex> lock{ring.mutex};
+    ring.events[ring.head % RING_SIZE] = event;
+    ++ring.head;
+}
+
+void Profiler::end_frame()
+{
+    if (!is_enabled()) {
+        return;
+    }
+
+    // Gather the events that ended during this frame. Rings are in order of
+    // completion, so the walk stops at the first one that ended earlier.
+    frame_events.clear();
+    {
+        std::lock_guard<std::mutex> rings_lock{rings_mutex};
+        for (const auto& ring : rings) {
+            std::lock_guard<std::mutex> lock{ring->mutex};
+
+            std::size_t first
+                = ring->head > RING_SIZE ? ring->head - RING_SIZE : 0;
+            for (std::size_t i = ring->head; i > first; --i) {
+                const Event& event = ring->events[(i - 1) % RING_SIZE];
+                if (event.start + event.duration < frame_start) {
+                    break;
+                }
+
+                frame_events.push_back(event);
+            }
+        }
+    }
+
+    frame_start = nanoseconds(clock::now() - epoch);
+
+    // Sorting by start time puts parents before their children, so new
+    // phases are appended in an order that can be shown as a tree.
+    std::sort(frame_events.begin(),
+              frame_events.end(),
+              [](const Event& a, const Event& b) {
+                  return a.start != b.start ? a.start < b.start
+                                            : a.depth < b.depth;
+              });
+
+    for (Phase& phase : phases) {
+        phase.last_ms = 0.0;
+    }
+
+    for (const Event& event : frame_events) {
+        auto iter = std::find_if(
+            phases.begin(), phases.end(), [&](const Phase& phase) {
+                return phase.name == event.name;
+            });
+        if (iter == phases.end()) {
+            iter = phases.insert(phases.end(), Phase{event.name, event.depth});
+        }
+
+        iter->last_ms += event.duration / 1'000'000.0;
+    }
+
+    for (Phase& phase : phases) {
+        phase.average_ms = frame_count
+                               ? phase.average_ms * 0.95 + phase.last_ms * 0.05
+                               : phase.last_ms;
+        phase.window_peak_ms = std::max(phase.window_peak_ms, phase.last_ms);
+        phase.peak_ms = std::max(phase.window_peak_ms, phase.previous_peak_ms);
+    }
+
+    if (++frame_count % PEAK_WINDOW == 0) {
+        for (Phase& phase : phases) {
+            phase.previous_peak_ms = phase.window_peak_ms;
+            phase.window_peak_ms = 0.0;
+        }
+    }
+}
+
+const std::vector<Profiler::Phase>& Profiler::get_phases() const noexcept
+{
+    return phases;
+}
+
+bool Profiler::export_trace(const std::string& filename) const
+{
+    std::ofstream file{filename};
+    if (!file) {
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+    bool first = true;
+    std::lock_guard<std::mutex> rings_lock{rings_mutex};
+    for (const auto& ring : rings) {
+        std::lock_guard<std::mutex> lock{ring->mutex};
+
+        std::size_t begin
+            = ring->head > RING_SIZE ? ring->head - RING_SIZE : 0;
+        for (std::size_t i = begin; i < ring->head; ++i) {
+            const Event& event = ring->events[i % RING_SIZE];
+
+            // Timestamps and durations are in microseconds.
+            file << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->thread_index
+                 << ",\"ts\":" << event.start / 1'000.0
+                 << ",\"dur\":" << event.duration / 1'000.0 << '}';
+            first = false;
+        }
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return static_cast<bool>(file);
+}
+
+Profiler::Ring& Profiler::local_ring()
+{
+    thread_local std::shared_ptr<Ring> ring;
+
+    if (!ring) {
+        ring = std::make_shared<Ring>();
+
+        std::lock_guard<std::mutex> lock{rings_mutex};
+        ring->thread_index = rings.size();
+        rings.push_back(ring);
+    }
+
+    return *ring;
+}
+} // namespace jrc
@@ -0,0 +1,154 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the LibreMaple MMORPG client                        //
+// Copyright © 2015-2016 Daniel Allendorf, 2018-2019 LibreMaple Team        //
+//                                                                          //
+// This program is free software: you can redistribute it and/or modify     //
+// it under the terms of the GNU Affero General Public License as           //
+// published by the Free Software Foundation, either version 3 of the       //
+// License, or (at your option) any later version.                          //
+//                                                                          //
+// This program is distributed in the hope that it will be useful,          //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of           //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            //
+// GNU Affero General Public License for more details.                      //
+//                                                                          //
+// You should have received a copy of the GNU Affero General Public License //
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.   //
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../Template/Singleton.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace jrc
+{
+//! Records how long named scopes of code take, into a ring buffer per
+//! thread. The recorded events feed the profiler overlay and can be
+//! exported as a Chrome trace (`chrome://tracing` or Perfetto).
+//!
+//! Recording is off by default; while off, a `ProfileScope` costs a single
+//! relaxed atomic load.
+class Profiler : public Singleton<Profiler>
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    //! Events kept per thread. Older events are overwritten.
+    static constexpr std::size_t RING_SIZE = 1 << 14;
+
+    //! Timing of one scope, aggregated over the frames recorded so far.
+    struct Phase {
+        const char* name;
+        //! Nesting depth of the scope on its thread.
+        std::uint8_t depth;
+        //! Time spent in the scope during the last frame.
+        double last_ms = 0.0;
+        //! Exponential moving average of the time per frame.
+        double average_ms = 0.0;
+        //! Highest time per frame over the current and the previous window
+        //! of `PEAK_WINDOW` frames.
+        double peak_ms = 0.0;
+        double window_peak_ms = 0.0;
+        double previous_peak_ms = 0.0;
+    };
+
+    Profiler();
+
+    void set_enabled(bool enabled) noexcept;
+    bool is_enabled() const noexcept
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    //! Record a scope of the calling thread. `name` must outlive the
+    //! profiler, i.e. be a string literal.
+    void record(const char* name,
+                std::uint8_t depth,
+                clock::time_point start,
+                clock::time_point end);
+
+    //! Mark the end of a frame, folding the events recorded since the last
+    //! call into the per-phase statistics.
+    void end_frame();
+    //! Return the per-phase statistics, parents before their children.
+    const std::vector<Phase>& get_phases() const noexcept;
+
+    //! Write all buffered events to `filename` in the Chrome trace event
+    //! format. Returns false if the file could not be written.
+    bool export_trace(const std::string& filename) const;
+
+private:
+    struct Event {
+        const char* name;
+        std::uint8_t depth;
+        //! Nanoseconds since the profiler was constructed.
+        std::int64_t start;
+        std::int64_t duration;
+    };
+
+    struct Ring {
+        std::mutex mutex;
+        std::array<Event, RING_SIZE> events;
+        //! Number of events ever written; the next one goes to
+        //! `events[head % RING_SIZE]`.
+        std::size_t head = 0;
+        std::size_t thread_index;
+    };
+
+    static constexpr std::size_t PEAK_WINDOW = 120;
+
+    Ring& local_ring();
+
+    std::atomic<bool> enabled;
+    clock::time_point epoch;
+    std::int64_t frame_start;
+    std::size_t frame_count;
+
+    mutable std::mutex rings_mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    std::vector<Phase> phases;
+    std::vector<Event> frame_events;
+};
+
+//! Times the enclosing scope under the given name while the profiler is
+//! enabled.
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* scope_name) noexcept
+        : name{Profiler::get().is_enabled() ? scope_name : nullptr}
+    {
+        if (name) {
+            depth = nesting++;
+            start = Profiler::clock::now();
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (name) {
+            --nesting;
+            Profiler::get().record(
+                name, depth, start, Profiler::clock::now());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    std::uint8_t depth = 0;
+    Profiler::clock::time_point start;
+
+    inline static thread_local std::uint8_t nesting = 0;
+};
+} // namespace jrc
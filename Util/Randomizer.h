@@ -27,6 +27,13 @@ namespace jrc
 class Randomizer
 {
 public:
+    //! Reseed the generator of the calling thread, making the numbers it
+    //! produces from here on reproducible.
+    static void seed(std::uint64_t value) noexcept
+    {
+        state.rng.seed(value);
+    }
+
     static bool next_bool() noexcept
     {
         return next_int(2) == 1;